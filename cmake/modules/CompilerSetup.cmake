@@ -38,12 +38,17 @@ endif()
 # Create upper-case copy of the project name for variable prefixes
 string(TOUPPER ${PROJECT_NAME} PROJECT_NAME_UPPER)
 
-# Enable support for different sanitizers when building with clang
-if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+# Enable support for different sanitizers when building with clang or GCC
+if(CMAKE_CXX_COMPILER_ID MATCHES "Clang|GNU")
   option(${PROJECT_NAME_UPPER}_ENABLE_ASAN "Enable ASan (address sanitization)" OFF)
   option(${PROJECT_NAME_UPPER}_ENABLE_UBSAN "Enable UBSan (undefined-behavior sanitization)" OFF)
+  option(${PROJECT_NAME_UPPER}_ENABLE_TSAN "Enable TSan (thread sanitization)" OFF)
 
-  if(${PROJECT_NAME_UPPER}_ENABLE_ASAN OR ${PROJECT_NAME_UPPER}_ENABLE_UBSAN)
+  if(${PROJECT_NAME_UPPER}_ENABLE_TSAN AND ${PROJECT_NAME_UPPER}_ENABLE_ASAN)
+    message(FATAL_ERROR "TSan cannot be combined with ASan")
+  endif()
+
+  if(${PROJECT_NAME_UPPER}_ENABLE_ASAN OR ${PROJECT_NAME_UPPER}_ENABLE_UBSAN OR ${PROJECT_NAME_UPPER}_ENABLE_TSAN)
     set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -fno-omit-frame-pointer")
     set(SANITIZERS "")
 
@@ -55,6 +60,10 @@ if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
       list(APPEND SANITIZERS "undefined")
     endif()
 
+    if(${PROJECT_NAME_UPPER}_ENABLE_TSAN)
+      list(APPEND SANITIZERS "thread")
+    endif()
+
     string(REPLACE ";" "," SANITIZERS "${SANITIZERS}")
     set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -fsanitize=${SANITIZERS}")
   endif()
@@ -13,6 +13,8 @@
  */
 
 #include "sophia/concept/concept.hpp"
+#include "sophia/data/data.hpp"
+#include "sophia/instrument/instrument.hpp"
 #include "sophia/io/io.hpp"
 #include "sophia/meta/meta.hpp"
 #include "sophia/string/string.hpp"
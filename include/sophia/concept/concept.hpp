@@ -21,6 +21,7 @@
  * implementation of the concepts verifies that a type, or its functions, look like they satify the concept.
  */
 
+#include "sophia/concept/format.hpp"
 #include "sophia/concept/io.hpp"
 #include "sophia/concept/type_descriptor.hpp"
 
@@ -0,0 +1,46 @@
+#ifndef SOPHIA_CONCEPT__FORMAT
+#define SOPHIA_CONCEPT__FORMAT
+
+#include "sophia/meta/void_t.hpp"
+#include "sophia/string/formatter.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace sophia::concept
+  {
+
+  /**
+   * @ingroup sophia_concept
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The concept of a type being able to be formatted via a specialization of sophia::formatter
+   *
+   * This type alias is defined for types for which #sophia::formatter is specialized. The specialization must provide a
+   * member function @p max_size taking a @p Type @p const @p & and returning something convertible to @p std::size_t, and
+   * a member function @p format taking a @p Type @p const @p & and a @p char @p * and returning @p char @p *.
+   *
+   * @tparam Type The type that has to satisfy the concept
+   */
+  template<typename Type>
+  using formatable = meta::void_t<
+    std::enable_if_t<
+      std::conjunction<
+        std::is_default_constructible<formatter<Type>>,
+        std::is_convertible<
+          decltype(std::declval<formatter<Type> &>().max_size(std::declval<Type const &>())),
+          std::size_t
+        >,
+        std::is_same<
+          decltype(std::declval<formatter<Type> &>().format(std::declval<Type const &>(), std::declval<char *>())),
+          char *
+        >
+      >::value,
+      Type
+    >
+  >;
+
+  }
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef SOPHIA_DATA__DATA
+#define SOPHIA_DATA__DATA
+
+/**
+ * @namespace sophia::data
+ * @author Felix Morgner
+ * @since 0.3
+ *
+ * @brief The Sophia Template Library Data Structures module
+ */
+
+/**
+ * @defgroup sophia_data Data Structures
+ */
+
+#include "sophia/data/flat_hash_map.hpp"
+#include "sophia/data/flat_hash_set.hpp"
+#include "sophia/data/small_vector.hpp"
+#include "sophia/data/string.hpp"
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef SOPHIA_DATA__FLAT_HASH_MAP
+#define SOPHIA_DATA__FLAT_HASH_MAP
+
+#include "sophia/data/hash_table.hpp"
+
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sophia::data
+  {
+
+  namespace internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief The element policy of #sophia::data::flat_hash_map
+     */
+    template<typename KeyType, typename MappedType>
+    struct map_policy
+      {
+      using key_type = KeyType;
+      using value_type = std::pair<KeyType const, MappedType>;
+
+      static constexpr bool mutable_elements{true};
+
+      static KeyType const & key(value_type const & value)
+        {
+        return value.first;
+        }
+
+      /**
+       * @internal
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Whether #transfer can not throw, and thus may move from the source element
+       */
+      static constexpr bool nothrow_transfer{std::is_nothrow_copy_constructible<KeyType>::value &&
+                                             std::is_nothrow_move_constructible<MappedType>::value};
+
+      /**
+       * @internal
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Construct a copy of an element in uninitialized storage
+       *
+       * The key is always copied, since it is const in the source element. The mapped value is moved if that cannot fail,
+       * or if it cannot be copied. Otherwise, it is copied as well, so that the source element is left intact if an
+       * exception is thrown.
+       */
+      static void transfer(value_type * target, value_type * source)
+        {
+        if constexpr(nothrow_transfer || !std::is_copy_constructible<MappedType>::value)
+          {
+          ::new(static_cast<void *>(target)) value_type(source->first, std::move(source->second));
+          }
+        else
+          {
+          ::new(static_cast<void *>(target)) value_type(source->first, source->second);
+          }
+        }
+      };
+
+    }
+
+  /**
+   * @ingroup sophia_data
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief An unordered associative container storing its elements in a flat open-addressing hash table
+   *
+   * The interface of this container follows @p std::unordered_map, with the following differences:
+   *   - Elements are stored inline in a single array, not in separately allocated nodes. Inserting or erasing elements and
+   *     rehashing invalidate all iterators, pointers and references to elements.
+   *   - The container has no bucket interface, and its maximum load factor is fixed at 0.875.
+   *   - If the hasher and the key comparator are transparent, the lookup functions accept any key type that they support.
+   *     With the default hasher and key comparator, this allows looking up @p std::string keys by @p std::string_view or
+   *     string literal.
+   *
+   * @par Example:
+   * @rst
+   * .. code-block:: c++
+   *    :linenos:
+   *
+   *    #include <sophia/data/flat_hash_map.hpp>
+   *
+   *    #include <string>
+   *    #include <string_view>
+   *
+   *    int main()
+   *      {
+   *      auto ages = sophia::data::flat_hash_map<std::string, int>{{"alice", 31}, {"bob", 27}};
+   *      auto const name = std::string_view{"bob"};
+   *      return ages.find(name)->second;
+   *      }
+   * @endrst
+   */
+  template<typename KeyType,
+           typename MappedType,
+           typename HashType = hash<KeyType>,
+           typename KeyEqualType = std::equal_to<>>
+  struct flat_hash_map : internal::hash_table<internal::map_policy<KeyType, MappedType>, HashType, KeyEqualType>
+    {
+    private:
+      using base = internal::hash_table<internal::map_policy<KeyType, MappedType>, HashType, KeyEqualType>;
+
+    public:
+      using mapped_type = MappedType;
+      using typename base::key_type;
+      using typename base::value_type;
+      using typename base::iterator;
+      using typename base::const_iterator;
+
+      using base::base;
+      using base::insert;
+
+      flat_hash_map() = default;
+
+      template<typename ValueType, typename = std::enable_if_t<std::is_constructible<value_type, ValueType &&>::value>>
+      std::pair<iterator, bool> insert(ValueType && value)
+        {
+        return this->emplace(std::forward<ValueType>(value));
+        }
+
+      /**
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Insert an element with the given key and a mapped value constructed from the given arguments, unless an
+       * element with the given key exists
+       */
+      template<typename ...ArgumentTypes>
+      std::pair<iterator, bool> try_emplace(key_type const & key, ArgumentTypes && ...arguments)
+        {
+        return this->emplace_key(key,
+                                 std::piecewise_construct,
+                                 std::forward_as_tuple(key),
+                                 std::forward_as_tuple(std::forward<ArgumentTypes>(arguments)...));
+        }
+
+      template<typename ...ArgumentTypes>
+      std::pair<iterator, bool> try_emplace(key_type && key, ArgumentTypes && ...arguments)
+        {
+        return this->emplace_key(key,
+                                 std::piecewise_construct,
+                                 std::forward_as_tuple(std::move(key)),
+                                 std::forward_as_tuple(std::forward<ArgumentTypes>(arguments)...));
+        }
+
+      /**
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Insert an element, or assign to the mapped value of the element with the given key if it exists
+       */
+      template<typename KeyArgumentType, typename ValueType>
+      std::pair<iterator, bool> insert_or_assign(KeyArgumentType && key, ValueType && value)
+        {
+        auto result = try_emplace(std::forward<KeyArgumentType>(key), std::forward<ValueType>(value));
+        if(!result.second)
+          {
+          result.first->second = std::forward<ValueType>(value);
+          }
+        return result;
+        }
+
+      /**
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Access the mapped value of the element with the given key, inserting a value-initialized one if necessary
+       */
+      mapped_type & operator[](key_type const & key)
+        {
+        return try_emplace(key).first->second;
+        }
+
+      mapped_type & operator[](key_type && key)
+        {
+        return try_emplace(std::move(key)).first->second;
+        }
+
+      /**
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Access the mapped value of the element with the given key
+       *
+       * @throw std::out_of_range if there is no element with the given key
+       */
+      template<typename LookupType = key_type>
+      mapped_type & at(typename base::template key_arg<LookupType> const & key)
+        {
+        auto const found = this->template find<LookupType>(key);
+        if(found == this->end())
+          {
+          throw std::out_of_range{"flat_hash_map::at: key not found"};
+          }
+        return found->second;
+        }
+
+      template<typename LookupType = key_type>
+      mapped_type const & at(typename base::template key_arg<LookupType> const & key) const
+        {
+        auto const found = this->template find<LookupType>(key);
+        if(found == this->end())
+          {
+          throw std::out_of_range{"flat_hash_map::at: key not found"};
+          }
+        return found->second;
+        }
+    };
+
+  template<typename KeyType, typename MappedType, typename HashType, typename KeyEqualType>
+  void swap(flat_hash_map<KeyType, MappedType, HashType, KeyEqualType> & lhs,
+            flat_hash_map<KeyType, MappedType, HashType, KeyEqualType> & rhs) noexcept
+    {
+    lhs.swap(rhs);
+    }
+
+  }
+
+#endif
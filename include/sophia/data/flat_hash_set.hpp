@@ -0,0 +1,78 @@
+#ifndef SOPHIA_DATA__FLAT_HASH_SET
+#define SOPHIA_DATA__FLAT_HASH_SET
+
+#include "sophia/data/hash_table.hpp"
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace sophia::data
+  {
+
+  namespace internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief The element policy of #sophia::data::flat_hash_set
+     */
+    template<typename KeyType>
+    struct set_policy
+      {
+      using key_type = KeyType;
+      using value_type = KeyType;
+
+      static constexpr bool mutable_elements{false};
+
+      static KeyType const & key(value_type const & value)
+        {
+        return value;
+        }
+
+      static constexpr bool nothrow_transfer{std::is_nothrow_move_constructible<KeyType>::value};
+
+      static void transfer(value_type * target, value_type * source)
+        {
+        ::new(static_cast<void *>(target)) value_type(std::move_if_noexcept(*source));
+        }
+      };
+
+    }
+
+  /**
+   * @ingroup sophia_data
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief An unordered set storing its elements in a flat open-addressing hash table
+   *
+   * The interface of this container follows @p std::unordered_set, with the same differences as described for
+   * #sophia::data::flat_hash_map.
+   */
+  template<typename KeyType,
+           typename HashType = hash<KeyType>,
+           typename KeyEqualType = std::equal_to<>>
+  struct flat_hash_set : internal::hash_table<internal::set_policy<KeyType>, HashType, KeyEqualType>
+    {
+    private:
+      using base = internal::hash_table<internal::set_policy<KeyType>, HashType, KeyEqualType>;
+
+    public:
+      using base::base;
+
+      flat_hash_set() = default;
+    };
+
+  template<typename KeyType, typename HashType, typename KeyEqualType>
+  void swap(flat_hash_set<KeyType, HashType, KeyEqualType> & lhs, flat_hash_set<KeyType, HashType, KeyEqualType> & rhs) noexcept
+    {
+    lhs.swap(rhs);
+    }
+
+  }
+
+#endif
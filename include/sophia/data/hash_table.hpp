@@ -0,0 +1,938 @@
+#ifndef SOPHIA_DATA__HASH_TABLE
+#define SOPHIA_DATA__HASH_TABLE
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace sophia::data
+  {
+
+  /**
+   * @ingroup sophia_data
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The default hash function of the flat hash containers
+   *
+   * For most types, this is @p std::hash. The specializations for @p std::string and @p std::string_view are transparent
+   * and hash any string-like object as a @p std::string_view, which enables looking up string keys without constructing a
+   * @p std::string.
+   */
+  template<typename KeyType>
+  struct hash : std::hash<KeyType>
+    {
+
+    };
+
+  template<>
+  struct hash<std::string>
+    {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view key) const noexcept
+      {
+      return std::hash<std::string_view>{}(key);
+      }
+    };
+
+  template<>
+  struct hash<std::string_view> : hash<std::string>
+    {
+
+    };
+
+  namespace internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief The type of the control bytes of a hash table
+     *
+     * A full slot is marked by the lowest seven bits of the hash of its key, and thus by a non-negative control byte. Empty
+     * and deleted slots are marked by negative control bytes.
+     */
+    using control_byte = std::int8_t;
+
+    constexpr control_byte empty_control{-128};
+    constexpr control_byte deleted_control{-2};
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief The number of control bytes examined in one probing step
+     */
+    constexpr std::size_t group_width{16};
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief A group of control bytes that can be matched against a control byte value in parallel
+     *
+     * Each match returns a bitmask in which bit @p n is set iff the control byte at offset @p n matches. Where SSE2 is
+     * available, all control bytes of a group are compared with a single instruction.
+     */
+    struct group
+      {
+      explicit group(control_byte const * position)
+#if defined(__SSE2__)
+        : m_control{_mm_loadu_si128(reinterpret_cast<__m128i const *>(position))}
+#endif
+        {
+#if !defined(__SSE2__)
+        std::memcpy(m_control, position, group_width);
+#endif
+        }
+
+      /**
+       * @internal
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Match the control bytes of full slots with the given hash bits
+       */
+      std::uint32_t match(control_byte hash) const
+        {
+#if defined(__SSE2__)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash), m_control)));
+#else
+        auto mask = std::uint32_t{};
+        for(auto index = 0ull; index < group_width; ++index)
+          {
+          mask |= static_cast<std::uint32_t>(m_control[index] == hash) << index;
+          }
+        return mask;
+#endif
+        }
+
+      /**
+       * @internal
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Match the control bytes of empty slots
+       */
+      std::uint32_t match_empty() const
+        {
+        return match(empty_control);
+        }
+
+      /**
+       * @internal
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Match the control bytes of empty or deleted slots
+       */
+      std::uint32_t match_empty_or_deleted() const
+        {
+#if defined(__SSE2__)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(m_control));
+#else
+        auto mask = std::uint32_t{};
+        for(auto index = 0ull; index < group_width; ++index)
+          {
+          mask |= static_cast<std::uint32_t>(m_control[index] < 0) << index;
+          }
+        return mask;
+#endif
+        }
+
+      private:
+#if defined(__SSE2__)
+        __m128i m_control;
+#else
+        control_byte m_control[group_width];
+#endif
+      };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Get the index of the lowest set bit of a non-zero group mask
+     */
+    inline std::size_t lowest_bit(std::uint32_t mask)
+      {
+      return static_cast<std::size_t>(__builtin_ctz(mask));
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Get the number of unset bits above the highest set bit of a non-zero group mask
+     */
+    inline std::size_t leading_zeros(std::uint32_t mask)
+      {
+      return static_cast<std::size_t>(__builtin_clz(mask)) - (32 - group_width);
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Scramble the bits of a hash value
+     *
+     * The table derives both the probe start and the control byte from the hash. Hash functions like @p std::hash for
+     * integers, which is the identity on common platforms, would otherwise map consecutive keys to the same control byte.
+     */
+    inline std::size_t mix(std::size_t hash)
+      {
+      auto const mixed = static_cast<std::uint64_t>(hash) * 0x9e3779b97f4a7c15ull;
+      return static_cast<std::size_t>(mixed ^ (mixed >> 32));
+      }
+
+    template<typename Type, typename = void>
+    struct is_transparent : std::false_type { };
+
+    template<typename Type>
+    struct is_transparent<Type, std::void_t<typename Type::is_transparent>> : std::true_type { };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Select the key type accepted by the lookup functions of a hash table
+     *
+     * The selection is made via a member alias template, instead of @p std::conditional, so that the key type can still be
+     * deduced from the argument of a lookup.
+     */
+    template<bool Transparent>
+    struct key_argument
+      {
+      template<typename LookupType, typename KeyType>
+      using type = LookupType;
+      };
+
+    template<>
+    struct key_argument<false>
+      {
+      template<typename LookupType, typename KeyType>
+      using type = KeyType;
+      };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief An iterator over the elements of a hash table
+     *
+     * The iterators and const iterators of a table are always distinct types, even if both only provide read access to the
+     * elements, as is the case for sets.
+     */
+    template<typename ValueType, typename ReferenceType, bool Constant>
+    struct table_iterator
+      {
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = ValueType;
+      using difference_type = std::ptrdiff_t;
+      using reference = ReferenceType;
+      using pointer = std::remove_reference_t<ReferenceType> *;
+
+      table_iterator() = default;
+
+      table_iterator(control_byte const * control, ValueType * slot, control_byte const * end)
+        : m_control{control},
+          m_slot{slot},
+          m_end{end}
+        {
+        skip();
+        }
+
+      template<typename OtherReferenceType, bool IsConstant = Constant, typename = std::enable_if_t<IsConstant>>
+      table_iterator(table_iterator<ValueType, OtherReferenceType, false> const & other)
+        : m_control{other.m_control},
+          m_slot{other.m_slot},
+          m_end{other.m_end}
+        {
+
+        }
+
+      reference operator*() const
+        {
+        return *m_slot;
+        }
+
+      pointer operator->() const
+        {
+        return m_slot;
+        }
+
+      table_iterator & operator++()
+        {
+        ++m_control;
+        ++m_slot;
+        skip();
+        return *this;
+        }
+
+      table_iterator operator++(int)
+        {
+        auto old = *this;
+        ++*this;
+        return old;
+        }
+
+      friend bool operator==(table_iterator const & lhs, table_iterator const & rhs)
+        {
+        return lhs.m_control == rhs.m_control;
+        }
+
+      friend bool operator!=(table_iterator const & lhs, table_iterator const & rhs)
+        {
+        return !(lhs == rhs);
+        }
+
+      control_byte const * m_control{};
+      ValueType * m_slot{};
+      control_byte const * m_end{};
+
+      private:
+        void skip()
+          {
+          while(m_control != m_end && *m_control < 0)
+            {
+            ++m_control;
+            ++m_slot;
+            }
+          }
+      };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief An open-addressing hash table storing its elements in a flat array
+     *
+     * The table follows the design of the "Swiss table": next to the array of element slots, the table keeps an array of
+     * control bytes, one per slot, that mark the slot as empty, deleted or full. A full slot stores seven bits of the hash of
+     * its key in its control byte. Lookups probe groups of 16 control bytes at once and only compare the keys of slots whose
+     * control byte matches, so that most misses never touch the element array at all. Groups are probed in a triangular
+     * sequence, which visits every group of a table whose capacity is a power of two.
+     *
+     * The first @p group_width control bytes are mirrored past the end of the control array, so that a group can be loaded
+     * at any slot index without wrapping around. The table grows once it is seven eighths full, counting deleted slots. When
+     * most of them are deleted slots, the table is rehashed at the same capacity instead. Deleting an element only leaves a
+     * deleted marker if the slot is part of a group that was completely full, since only then can a probe sequence have
+     * continued past it. This keeps long probe sequences rare, even with high load factors and many deletions.
+     *
+     * When the table is rehashed, elements are only moved to the new slots if their policy can transfer them without
+     * throwing. Otherwise they are copied if possible, and the old slots are restored if a copy throws. Only if the hasher
+     * throws while elements are being moved, the elements not moved so far are lost.
+     *
+     * @tparam PolicyType Describes the element type and how to extract the key from an element
+     */
+    template<typename PolicyType, typename HashType, typename KeyEqualType>
+    struct hash_table
+      {
+      using key_type = typename PolicyType::key_type;
+      using value_type = typename PolicyType::value_type;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+      using hasher = HashType;
+      using key_equal = KeyEqualType;
+      using reference = value_type &;
+      using const_reference = value_type const &;
+      using iterator = table_iterator<value_type,
+                                      std::conditional_t<PolicyType::mutable_elements, reference, const_reference>,
+                                      false>;
+      using const_iterator = table_iterator<value_type, const_reference, true>;
+
+      /**
+       * @internal
+       * @brief The type of key accepted by the lookup functions, which is any type if the hasher and key comparator are
+       * transparent, and @p key_type otherwise
+       */
+      template<typename KeyType>
+      using key_arg = typename key_argument<is_transparent<HashType>::value && is_transparent<KeyEqualType>::value>
+                      ::template type<KeyType, key_type>;
+
+      hash_table() = default;
+
+      explicit hash_table(size_type bucket_count, hasher const & hash = hasher{}, key_equal const & equal = key_equal{})
+        : m_hash{hash},
+          m_equal{equal}
+        {
+        reserve(bucket_count);
+        }
+
+      template<typename IteratorType>
+      hash_table(IteratorType first,
+                 IteratorType last,
+                 size_type bucket_count = 0,
+                 hasher const & hash = hasher{},
+                 key_equal const & equal = key_equal{})
+        : hash_table(bucket_count, hash, equal)
+        {
+        insert(first, last);
+        }
+
+      hash_table(std::initializer_list<value_type> values,
+                 size_type bucket_count = 0,
+                 hasher const & hash = hasher{},
+                 key_equal const & equal = key_equal{})
+        : hash_table(values.begin(), values.end(), bucket_count, hash, equal)
+        {
+
+        }
+
+      hash_table(hash_table const & other)
+        : hash_table(other.size(), other.m_hash, other.m_equal)
+        {
+        for(auto const & value : other)
+          {
+          auto const hash = hash_of(PolicyType::key(value));
+          auto const index = prepare_insert(hash);
+          ::new(static_cast<void *>(m_slots + index)) value_type(value);
+          commit_insert(index, hash);
+          }
+        }
+
+      hash_table(hash_table && other) noexcept
+        : m_control{std::exchange(other.m_control, nullptr)},
+          m_slots{std::exchange(other.m_slots, nullptr)},
+          m_capacity{std::exchange(other.m_capacity, 0)},
+          m_size{std::exchange(other.m_size, 0)},
+          m_growth_left{std::exchange(other.m_growth_left, 0)},
+          m_hash{other.m_hash},
+          m_equal{other.m_equal}
+        {
+
+        }
+
+      hash_table & operator=(hash_table other) noexcept
+        {
+        swap(other);
+        return *this;
+        }
+
+      ~hash_table()
+        {
+        destroy_elements();
+        deallocate();
+        }
+
+      iterator begin() noexcept
+        {
+        return {m_control, m_slots, m_control + m_capacity};
+        }
+
+      const_iterator begin() const noexcept
+        {
+        return {m_control, m_slots, m_control + m_capacity};
+        }
+
+      const_iterator cbegin() const noexcept
+        {
+        return begin();
+        }
+
+      iterator end() noexcept
+        {
+        return iterator_at(m_capacity);
+        }
+
+      const_iterator end() const noexcept
+        {
+        return iterator_at(m_capacity);
+        }
+
+      const_iterator cend() const noexcept
+        {
+        return end();
+        }
+
+      bool empty() const noexcept
+        {
+        return !m_size;
+        }
+
+      size_type size() const noexcept
+        {
+        return m_size;
+        }
+
+      size_type max_size() const noexcept
+        {
+        return std::numeric_limits<difference_type>::max() / sizeof(value_type);
+        }
+
+      /**
+       * @internal
+       * @brief Get the number of slots
+       */
+      size_type bucket_count() const noexcept
+        {
+        return m_capacity;
+        }
+
+      float load_factor() const noexcept
+        {
+        return m_capacity ? static_cast<float>(m_size) / static_cast<float>(m_capacity) : 0.0f;
+        }
+
+      float max_load_factor() const noexcept
+        {
+        return 0.875f;
+        }
+
+      /**
+       * @internal
+       * @brief Remove all elements, keeping the allocated slots
+       */
+      void clear() noexcept
+        {
+        destroy_elements();
+        if(m_capacity)
+          {
+          std::memset(m_control, empty_control, m_capacity + group_width);
+          }
+        m_size = 0;
+        m_growth_left = growth_limit(m_capacity);
+        }
+
+      /**
+       * @internal
+       * @brief Make room for at least @p count elements without rehashing
+       */
+      void reserve(size_type count)
+        {
+        if(count > m_size + m_growth_left)
+          {
+          resize(capacity_for(count));
+          }
+        }
+
+      /**
+       * @internal
+       * @brief Rehash the table to the smallest capacity that can hold @p count elements as well as the current elements
+       */
+      void rehash(size_type count)
+        {
+        auto const capacity = capacity_for(std::max(count, m_size));
+        if(capacity != m_capacity || m_size + m_growth_left < growth_limit(m_capacity))
+          {
+          resize(capacity);
+          }
+        }
+
+      std::pair<iterator, bool> insert(value_type const & value)
+        {
+        return emplace_key(PolicyType::key(value), value);
+        }
+
+      std::pair<iterator, bool> insert(value_type && value)
+        {
+        return emplace_key(PolicyType::key(value), std::move(value));
+        }
+
+      template<typename IteratorType>
+      void insert(IteratorType first, IteratorType last)
+        {
+        for(; first != last; ++first)
+          {
+          insert(*first);
+          }
+        }
+
+      void insert(std::initializer_list<value_type> values)
+        {
+        insert(values.begin(), values.end());
+        }
+
+      template<typename ...ArgumentTypes>
+      std::pair<iterator, bool> emplace(ArgumentTypes && ...arguments)
+        {
+        return insert(value_type(std::forward<ArgumentTypes>(arguments)...));
+        }
+
+      template<typename KeyType = key_type>
+      iterator find(key_arg<KeyType> const & key)
+        {
+        return iterator_at(find_index(key, hash_of(key)));
+        }
+
+      template<typename KeyType = key_type>
+      const_iterator find(key_arg<KeyType> const & key) const
+        {
+        return iterator_at(find_index(key, hash_of(key)));
+        }
+
+      template<typename KeyType = key_type>
+      bool contains(key_arg<KeyType> const & key) const
+        {
+        return find_index(key, hash_of(key)) != m_capacity;
+        }
+
+      template<typename KeyType = key_type>
+      size_type count(key_arg<KeyType> const & key) const
+        {
+        return contains(key);
+        }
+
+      template<typename KeyType = key_type>
+      size_type erase(key_arg<KeyType> const & key)
+        {
+        auto const index = find_index(key, hash_of(key));
+        if(index == m_capacity)
+          {
+          return 0;
+          }
+        erase_at(index);
+        return 1;
+        }
+
+      iterator erase(const_iterator position)
+        {
+        auto const index = static_cast<size_type>(position.m_control - m_control);
+        erase_at(index);
+        return iterator_at(index + 1);
+        }
+
+      iterator erase(iterator position)
+        {
+        return erase(const_iterator{position});
+        }
+
+      void swap(hash_table & other) noexcept
+        {
+        using std::swap;
+        swap(m_control, other.m_control);
+        swap(m_slots, other.m_slots);
+        swap(m_capacity, other.m_capacity);
+        swap(m_size, other.m_size);
+        swap(m_growth_left, other.m_growth_left);
+        swap(m_hash, other.m_hash);
+        swap(m_equal, other.m_equal);
+        }
+
+      hasher hash_function() const
+        {
+        return m_hash;
+        }
+
+      key_equal key_eq() const
+        {
+        return m_equal;
+        }
+
+      protected:
+        template<typename KeyType>
+        size_type hash_of(KeyType const & key) const
+          {
+          return mix(m_hash(key));
+          }
+
+        /**
+         * Find the slot holding the given key, returning @p m_capacity if there is none.
+         */
+        template<typename KeyType>
+        size_type find_index(KeyType const & key, size_type hash) const
+          {
+          if(!m_size)
+            {
+            return m_capacity;
+            }
+
+          auto const mask = m_capacity - 1;
+          auto const fingerprint = static_cast<control_byte>(hash & 0x7f);
+          auto position = (hash >> 7) & mask;
+          for(auto step = group_width;; step += group_width)
+            {
+            auto const current = group{m_control + position};
+            for(auto matches = current.match(fingerprint); matches; matches &= matches - 1)
+              {
+              auto const index = (position + lowest_bit(matches)) & mask;
+              if(m_equal(PolicyType::key(m_slots[index]), key))
+                {
+                return index;
+                }
+              }
+
+            if(current.match_empty())
+              {
+              return m_capacity;
+              }
+            position = (position + step) & mask;
+            }
+          }
+
+        /**
+         * Insert a new element constructed from the given arguments, unless an element with the given key exists.
+         */
+        template<typename KeyType, typename ...ArgumentTypes>
+        std::pair<iterator, bool> emplace_key(KeyType const & key, ArgumentTypes && ...arguments)
+          {
+          auto const hash = hash_of(key);
+          auto const existing = find_index(key, hash);
+          if(existing != m_capacity)
+            {
+            return {iterator_at(existing), false};
+            }
+
+          auto const index = prepare_insert(hash);
+          ::new(static_cast<void *>(m_slots + index)) value_type(std::forward<ArgumentTypes>(arguments)...);
+          commit_insert(index, hash);
+          return {iterator_at(index), true};
+          }
+
+        iterator iterator_at(size_type index) noexcept
+          {
+          return {m_control + index, m_slots + index, m_control + m_capacity};
+          }
+
+        const_iterator iterator_at(size_type index) const noexcept
+          {
+          return {m_control + index, m_slots + index, m_control + m_capacity};
+          }
+
+      private:
+        using slot_allocator = std::allocator<value_type>;
+        using control_allocator = std::allocator<control_byte>;
+
+        static size_type growth_limit(size_type capacity)
+          {
+          return capacity - capacity / 8;
+          }
+
+        static size_type capacity_for(size_type count)
+          {
+          auto capacity = group_width;
+          while(growth_limit(capacity) < count)
+            {
+            capacity *= 2;
+            }
+          return capacity;
+          }
+
+        void set_control(size_type index, control_byte value)
+          {
+          m_control[index] = value;
+          if(index < group_width)
+            {
+            m_control[m_capacity + index] = value;
+            }
+          }
+
+        /**
+         * Find the first empty or deleted slot in the probe sequence of the given hash.
+         */
+        size_type find_free(size_type hash) const
+          {
+          auto const mask = m_capacity - 1;
+          auto position = (hash >> 7) & mask;
+          for(auto step = group_width;; step += group_width)
+            {
+            if(auto const free = group{m_control + position}.match_empty_or_deleted())
+              {
+              return (position + lowest_bit(free)) & mask;
+              }
+            position = (position + step) & mask;
+            }
+          }
+
+        /**
+         * Find a slot for a new element with the given hash, growing the table if necessary. Reusing a deleted slot never
+         * requires the table to grow.
+         */
+        size_type prepare_insert(size_type hash)
+          {
+          auto index = m_capacity ? find_free(hash) : 0;
+          if(!m_growth_left && (!m_capacity || m_control[index] != deleted_control))
+            {
+            if(m_capacity && m_size <= growth_limit(m_capacity) / 2)
+              {
+              resize(m_capacity);
+              }
+            else
+              {
+              resize(m_capacity ? m_capacity * 2 : group_width);
+              }
+            index = find_free(hash);
+            }
+          return index;
+          }
+
+        void commit_insert(size_type index, size_type hash)
+          {
+          m_growth_left -= m_control[index] == empty_control;
+          set_control(index, static_cast<control_byte>(hash & 0x7f));
+          ++m_size;
+          }
+
+        void erase_at(size_type index)
+          {
+          auto const mask = m_capacity - 1;
+          auto const empty_after = group{m_control + index}.match_empty();
+          auto const empty_before = group{m_control + ((index - group_width) & mask)}.match_empty();
+          auto const never_full = empty_before && empty_after &&
+                                  lowest_bit(empty_after) + leading_zeros(empty_before) < group_width;
+
+          m_slots[index].~value_type();
+          set_control(index, never_full ? empty_control : deleted_control);
+          m_growth_left += never_full;
+          --m_size;
+          }
+
+        void resize(size_type capacity)
+          {
+          auto control_storage = control_allocator{};
+          auto slot_storage = slot_allocator{};
+
+          auto const control = control_storage.allocate(capacity + group_width);
+          auto const slots = [&]{
+            try
+              {
+              return slot_storage.allocate(capacity);
+              }
+            catch(...)
+              {
+              control_storage.deallocate(control, capacity + group_width);
+              throw;
+              }
+          }();
+          std::memset(control, empty_control, capacity + group_width);
+
+          auto const old_control = std::exchange(m_control, control);
+          auto const old_slots = std::exchange(m_slots, slots);
+          auto const old_capacity = std::exchange(m_capacity, capacity);
+
+          auto const destroy_old = [&](size_type first){
+            if constexpr(!std::is_trivially_destructible<value_type>::value)
+              {
+              for(auto index = first; index < old_capacity; ++index)
+                {
+                if(old_control[index] >= 0)
+                  {
+                  old_slots[index].~value_type();
+                  }
+                }
+              }
+          };
+
+          auto const deallocate_old = [&]{
+            if(old_capacity)
+              {
+              control_storage.deallocate(old_control, old_capacity + group_width);
+              slot_storage.deallocate(old_slots, old_capacity);
+              }
+          };
+
+          auto index = size_type{};
+          auto transferred = size_type{};
+          try
+            {
+            for(; index < old_capacity; ++index)
+              {
+              if(old_control[index] >= 0)
+                {
+                auto const hash = hash_of(PolicyType::key(old_slots[index]));
+                auto const target = find_free(hash);
+                PolicyType::transfer(m_slots + target, old_slots + index);
+                set_control(target, static_cast<control_byte>(hash & 0x7f));
+                ++transferred;
+
+                if constexpr(PolicyType::nothrow_transfer)
+                  {
+                  old_slots[index].~value_type();
+                  }
+                }
+              }
+            }
+          catch(...)
+            {
+            if constexpr(PolicyType::nothrow_transfer)
+              {
+              // Only the hasher can throw here. The moved elements cannot be put back without hashing their keys, so they
+              // are kept in the new slots, and the elements that were not moved yet are dropped.
+              destroy_old(index);
+              deallocate_old();
+              m_size = transferred;
+              m_growth_left = growth_limit(m_capacity) - m_size;
+              }
+            else
+              {
+              destroy_elements();
+              deallocate();
+              m_control = old_control;
+              m_slots = old_slots;
+              m_capacity = old_capacity;
+              }
+            throw;
+            }
+
+          if constexpr(!PolicyType::nothrow_transfer)
+            {
+            destroy_old(0);
+            }
+          deallocate_old();
+
+          m_growth_left = growth_limit(m_capacity) - m_size;
+          }
+
+        void destroy_elements() noexcept
+          {
+          if constexpr(!std::is_trivially_destructible<value_type>::value)
+            {
+            for(auto index = 0ull; index < m_capacity; ++index)
+              {
+              if(m_control[index] >= 0)
+                {
+                m_slots[index].~value_type();
+                }
+              }
+            }
+          }
+
+        void deallocate() noexcept
+          {
+          if(m_capacity)
+            {
+            control_allocator{}.deallocate(m_control, m_capacity + group_width);
+            slot_allocator{}.deallocate(m_slots, m_capacity);
+            }
+          }
+
+        control_byte * m_control{};
+        value_type * m_slots{};
+        size_type m_capacity{};
+        size_type m_size{};
+        size_type m_growth_left{};
+        hasher m_hash{};
+        key_equal m_equal{};
+      };
+
+    }
+
+  }
+
+#endif
@@ -0,0 +1,927 @@
+#ifndef SOPHIA_DATA__SMALL_VECTOR
+#define SOPHIA_DATA__SMALL_VECTOR
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace sophia::data
+  {
+
+  /**
+   * @ingroup sophia_data
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Whether objects of the given type can be relocated by copying their bytes
+   *
+   * Relocating an object means moving it to a new address and destroying the original. For trivially relocatable types,
+   * this is equivalent to a @p std::memcpy of the object representation, which allows #sophia::data::small_vector to grow,
+   * insert and erase using bulk memory operations. By default, only trivially copyable types are considered trivially
+   * relocatable. The trait may be specialized for types that are known to be trivially relocatable, like most smart
+   * pointers and (non self-referential) containers.
+   */
+  template<typename Type>
+  struct is_trivially_relocatable : std::is_trivially_copyable<Type>
+    {
+
+    };
+
+  /**
+   * @ingroup sophia_data
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A sequence container storing up to @p InlineCapacity elements inside the container object itself
+   *
+   * As long as it holds no more than @p InlineCapacity elements, the container does not allocate any memory. Once it grows
+   * beyond that, its elements are moved to a buffer obtained from the allocator. The interface of this container follows
+   * @p std::vector, with the following differences:
+   *   - Moving or swapping a container whose elements are stored inline moves or swaps the individual elements, and thus
+   *     invalidates iterators, pointers and references to them.
+   *   - @p shrink_to_fit moves the elements back into the inline storage if they fit.
+   *   - Trivially relocatable elements (see #sophia::data::is_trivially_relocatable) are moved using bulk memory
+   *     operations, bypassing the allocator's @p construct and @p destroy.
+   *
+   * @par Example:
+   * @rst
+   * .. code-block:: c++
+   *    :linenos:
+   *
+   *    #include <sophia/data/small_vector.hpp>
+   *
+   *    #include <string>
+   *
+   *    int main()
+   *      {
+   *      auto tokens = sophia::data::small_vector<std::string, 8>{};
+   *      tokens.push_back("no");
+   *      tokens.push_back("allocation");
+   *      return tokens.size();
+   *      }
+   * @endrst
+   */
+  template<typename ValueType, std::size_t InlineCapacity, typename AllocatorType = std::allocator<ValueType>>
+  struct small_vector
+    {
+    static_assert(InlineCapacity > 0, "the inline capacity of a small_vector must not be zero");
+
+    private:
+      using traits = std::allocator_traits<AllocatorType>;
+
+      static constexpr bool relocatable{is_trivially_relocatable<ValueType>::value};
+
+    public:
+      using value_type = ValueType;
+      using allocator_type = AllocatorType;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = value_type &;
+      using const_reference = value_type const &;
+      using pointer = value_type *;
+      using const_pointer = value_type const *;
+      using iterator = value_type *;
+      using const_iterator = value_type const *;
+      using reverse_iterator = std::reverse_iterator<iterator>;
+      using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+      /**
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief The number of elements that can be stored without allocating memory
+       */
+      static constexpr size_type inline_capacity{InlineCapacity};
+
+      small_vector() noexcept(noexcept(AllocatorType{}))
+        : small_vector(AllocatorType{})
+        {
+
+        }
+
+      explicit small_vector(AllocatorType const & allocator) noexcept
+        : m_allocator{allocator}
+        {
+
+        }
+
+      small_vector(size_type count, value_type const & value, AllocatorType const & allocator = AllocatorType{})
+        : small_vector(allocator)
+        {
+        assign(count, value);
+        }
+
+      explicit small_vector(size_type count, AllocatorType const & allocator = AllocatorType{})
+        : small_vector(allocator)
+        {
+        resize(count);
+        }
+
+      template<typename IteratorType,
+               typename = std::enable_if_t<std::is_base_of<std::input_iterator_tag,
+                                                           typename std::iterator_traits<IteratorType>::iterator_category>::value>>
+      small_vector(IteratorType first, IteratorType last, AllocatorType const & allocator = AllocatorType{})
+        : small_vector(allocator)
+        {
+        assign(first, last);
+        }
+
+      small_vector(std::initializer_list<value_type> values, AllocatorType const & allocator = AllocatorType{})
+        : small_vector(values.begin(), values.end(), allocator)
+        {
+
+        }
+
+      small_vector(small_vector const & other)
+        : small_vector(other, traits::select_on_container_copy_construction(other.m_allocator))
+        {
+
+        }
+
+      small_vector(small_vector const & other, AllocatorType const & allocator)
+        : small_vector(other.begin(), other.end(), allocator)
+        {
+
+        }
+
+      small_vector(small_vector && other) noexcept(std::is_nothrow_move_constructible<value_type>::value)
+        : m_allocator{std::move(other.m_allocator)}
+        {
+        take(other);
+        }
+
+      small_vector(small_vector && other, AllocatorType const & allocator)
+        : m_allocator{allocator}
+        {
+        if(other.is_inline() || m_allocator == other.m_allocator)
+          {
+          take(other);
+          }
+        else
+          {
+          assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+          other.clear();
+          }
+        }
+
+      ~small_vector()
+        {
+        destroy(begin(), end());
+        release();
+        }
+
+      small_vector & operator=(small_vector const & other)
+        {
+        if(this != &other)
+          {
+          if constexpr(traits::propagate_on_container_copy_assignment::value)
+            {
+            if(m_allocator != other.m_allocator)
+              {
+              clear();
+              release();
+              }
+            m_allocator = other.m_allocator;
+            }
+          assign(other.begin(), other.end());
+          }
+        return *this;
+        }
+
+      small_vector & operator=(small_vector && other) noexcept(std::is_nothrow_move_constructible<value_type>::value &&
+                                                              (traits::propagate_on_container_move_assignment::value ||
+                                                               traits::is_always_equal::value))
+        {
+        if(this == &other)
+          {
+          return *this;
+          }
+
+        clear();
+        if(traits::propagate_on_container_move_assignment::value || m_allocator == other.m_allocator || other.is_inline())
+          {
+          release();
+          if constexpr(traits::propagate_on_container_move_assignment::value)
+            {
+            m_allocator = std::move(other.m_allocator);
+            }
+          take(other);
+          }
+        else
+          {
+          assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+          other.clear();
+          }
+        return *this;
+        }
+
+      small_vector & operator=(std::initializer_list<value_type> values)
+        {
+        assign(values.begin(), values.end());
+        return *this;
+        }
+
+      void assign(size_type count, value_type const & value)
+        {
+        if(count > m_capacity)
+          {
+          auto const copy = value_type(value);
+          clear();
+          reallocate(count);
+          construct_n(begin(), count, copy);
+          m_size = count;
+          return;
+          }
+
+        std::fill(begin(), begin() + std::min(count, m_size), value);
+        if(count > m_size)
+          {
+          construct_n(end(), count - m_size, value);
+          }
+        else
+          {
+          destroy(begin() + count, end());
+          }
+        m_size = count;
+        }
+
+      template<typename IteratorType,
+               typename = std::enable_if_t<std::is_base_of<std::input_iterator_tag,
+                                                           typename std::iterator_traits<IteratorType>::iterator_category>::value>>
+      void assign(IteratorType first, IteratorType last)
+        {
+        clear();
+        insert(end(), first, last);
+        }
+
+      void assign(std::initializer_list<value_type> values)
+        {
+        assign(values.begin(), values.end());
+        }
+
+      allocator_type get_allocator() const noexcept
+        {
+        return m_allocator;
+        }
+
+      reference at(size_type index)
+        {
+        if(index >= m_size)
+          {
+          throw std::out_of_range{"small_vector::at: index out of range"};
+          }
+        return m_data[index];
+        }
+
+      const_reference at(size_type index) const
+        {
+        if(index >= m_size)
+          {
+          throw std::out_of_range{"small_vector::at: index out of range"};
+          }
+        return m_data[index];
+        }
+
+      reference operator[](size_type index) noexcept
+        {
+        return m_data[index];
+        }
+
+      const_reference operator[](size_type index) const noexcept
+        {
+        return m_data[index];
+        }
+
+      reference front() noexcept
+        {
+        return *m_data;
+        }
+
+      const_reference front() const noexcept
+        {
+        return *m_data;
+        }
+
+      reference back() noexcept
+        {
+        return m_data[m_size - 1];
+        }
+
+      const_reference back() const noexcept
+        {
+        return m_data[m_size - 1];
+        }
+
+      pointer data() noexcept
+        {
+        return m_data;
+        }
+
+      const_pointer data() const noexcept
+        {
+        return m_data;
+        }
+
+      iterator begin() noexcept
+        {
+        return m_data;
+        }
+
+      const_iterator begin() const noexcept
+        {
+        return m_data;
+        }
+
+      const_iterator cbegin() const noexcept
+        {
+        return m_data;
+        }
+
+      iterator end() noexcept
+        {
+        return m_data + m_size;
+        }
+
+      const_iterator end() const noexcept
+        {
+        return m_data + m_size;
+        }
+
+      const_iterator cend() const noexcept
+        {
+        return m_data + m_size;
+        }
+
+      reverse_iterator rbegin() noexcept
+        {
+        return reverse_iterator{end()};
+        }
+
+      const_reverse_iterator rbegin() const noexcept
+        {
+        return const_reverse_iterator{end()};
+        }
+
+      const_reverse_iterator crbegin() const noexcept
+        {
+        return rbegin();
+        }
+
+      reverse_iterator rend() noexcept
+        {
+        return reverse_iterator{begin()};
+        }
+
+      const_reverse_iterator rend() const noexcept
+        {
+        return const_reverse_iterator{begin()};
+        }
+
+      const_reverse_iterator crend() const noexcept
+        {
+        return rend();
+        }
+
+      bool empty() const noexcept
+        {
+        return !m_size;
+        }
+
+      size_type size() const noexcept
+        {
+        return m_size;
+        }
+
+      size_type max_size() const noexcept
+        {
+        return traits::max_size(m_allocator);
+        }
+
+      size_type capacity() const noexcept
+        {
+        return m_capacity;
+        }
+
+      /**
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Check whether the elements are stored inside the container object
+       */
+      bool is_inline() const noexcept
+        {
+        return m_data == inline_data();
+        }
+
+      void reserve(size_type count)
+        {
+        if(count > m_capacity)
+          {
+          reallocate(count);
+          }
+        }
+
+      /**
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Reduce the capacity to the number of elements, moving the elements back into the inline storage if they fit
+       */
+      void shrink_to_fit()
+        {
+        if(!is_inline() && m_size < m_capacity)
+          {
+          reallocate(m_size);
+          }
+        }
+
+      void clear() noexcept
+        {
+        destroy(begin(), end());
+        m_size = 0;
+        }
+
+      iterator insert(const_iterator position, value_type const & value)
+        {
+        return emplace(position, value);
+        }
+
+      iterator insert(const_iterator position, value_type && value)
+        {
+        return emplace(position, std::move(value));
+        }
+
+      iterator insert(const_iterator position, size_type count, value_type const & value)
+        {
+        auto const index = static_cast<size_type>(position - begin());
+        if(count)
+          {
+          auto const copy = value_type(value);
+          ensure_capacity(m_size + count);
+          construct_n(end(), count, copy);
+          m_size += count;
+          std::rotate(begin() + index, end() - count, end());
+          }
+        return begin() + index;
+        }
+
+      template<typename IteratorType,
+               typename = std::enable_if_t<std::is_base_of<std::input_iterator_tag,
+                                                           typename std::iterator_traits<IteratorType>::iterator_category>::value>>
+      iterator insert(const_iterator position, IteratorType first, IteratorType last)
+        {
+        auto const index = static_cast<size_type>(position - begin());
+        auto const old_size = m_size;
+
+        using category = typename std::iterator_traits<IteratorType>::iterator_category;
+        if constexpr(std::is_base_of<std::forward_iterator_tag, category>::value)
+          {
+          ensure_capacity(m_size + static_cast<size_type>(std::distance(first, last)));
+          }
+
+        try
+          {
+          for(; first != last; ++first)
+            {
+            emplace_back(*first);
+            }
+          }
+        catch(...)
+          {
+          destroy(begin() + old_size, end());
+          m_size = old_size;
+          throw;
+          }
+
+        std::rotate(begin() + index, begin() + old_size, end());
+        return begin() + index;
+        }
+
+      iterator insert(const_iterator position, std::initializer_list<value_type> values)
+        {
+        return insert(position, values.begin(), values.end());
+        }
+
+      template<typename ...ArgumentTypes>
+      iterator emplace(const_iterator position, ArgumentTypes && ...arguments)
+        {
+        auto const index = static_cast<size_type>(position - begin());
+        if(index == m_size)
+          {
+          emplace_back(std::forward<ArgumentTypes>(arguments)...);
+          return begin() + index;
+          }
+
+        auto value = value_type(std::forward<ArgumentTypes>(arguments)...);
+        ensure_capacity(m_size + 1);
+
+        auto const target = begin() + index;
+        if constexpr(relocatable)
+          {
+          std::memmove(static_cast<void *>(target + 1), static_cast<void const *>(target), (m_size - index) * sizeof(value_type));
+          try
+            {
+            traits::construct(m_allocator, target, std::move(value));
+            }
+          catch(...)
+            {
+            std::memmove(static_cast<void *>(target), static_cast<void const *>(target + 1), (m_size - index) * sizeof(value_type));
+            throw;
+            }
+          }
+        else
+          {
+          traits::construct(m_allocator, end(), std::move(back()));
+          std::move_backward(target, end() - 1, end());
+          *target = std::move(value);
+          }
+        ++m_size;
+        return target;
+        }
+
+      iterator erase(const_iterator position)
+        {
+        return erase(position, position + 1);
+        }
+
+      iterator erase(const_iterator first, const_iterator last)
+        {
+        auto const target = begin() + (first - begin());
+        auto const count = static_cast<size_type>(last - first);
+        if(count)
+          {
+          if constexpr(relocatable)
+            {
+            destroy(target, target + count);
+            auto const tail = static_cast<size_type>(end() - last);
+            std::memmove(static_cast<void *>(target), static_cast<void const *>(last), tail * sizeof(value_type));
+            }
+          else
+            {
+            destroy(std::move(target + count, end(), target), end());
+            }
+          m_size -= count;
+          }
+        return target;
+        }
+
+      void push_back(value_type const & value)
+        {
+        emplace_back(value);
+        }
+
+      void push_back(value_type && value)
+        {
+        emplace_back(std::move(value));
+        }
+
+      template<typename ...ArgumentTypes>
+      reference emplace_back(ArgumentTypes && ...arguments)
+        {
+        if(m_size == m_capacity)
+          {
+          return emplace_back_reallocating(std::forward<ArgumentTypes>(arguments)...);
+          }
+
+        traits::construct(m_allocator, end(), std::forward<ArgumentTypes>(arguments)...);
+        ++m_size;
+        return back();
+        }
+
+      void pop_back()
+        {
+        --m_size;
+        destroy(end(), end() + 1);
+        }
+
+      void resize(size_type count)
+        {
+        resize_with(count, [this](pointer target){ traits::construct(m_allocator, target); });
+        }
+
+      void resize(size_type count, value_type const & value)
+        {
+        resize_with(count, [this, &value](pointer target){ traits::construct(m_allocator, target, value); });
+        }
+
+      /**
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Exchange the contents of two containers
+       *
+       * If both containers store their elements on the heap, only the buffers are exchanged. Otherwise, the inline elements
+       * are moved individually.
+       */
+      void swap(small_vector & other)
+        {
+        if(this == &other)
+          {
+          return;
+          }
+
+        if constexpr(traits::propagate_on_container_swap::value)
+          {
+          using std::swap;
+          swap(m_allocator, other.m_allocator);
+          }
+
+        if(!is_inline() && !other.is_inline())
+          {
+          std::swap(m_data, other.m_data);
+          std::swap(m_size, other.m_size);
+          std::swap(m_capacity, other.m_capacity);
+          return;
+          }
+
+        auto temporary = small_vector(std::move(other));
+        other.take(*this);
+        take(temporary);
+        }
+
+    private:
+      pointer inline_data() noexcept
+        {
+        return reinterpret_cast<pointer>(m_inline);
+        }
+
+      const_pointer inline_data() const noexcept
+        {
+        return reinterpret_cast<const_pointer>(m_inline);
+        }
+
+      size_type grown_capacity(size_type required) const
+        {
+        if(required > max_size())
+          {
+          throw std::length_error{"small_vector: maximum size exceeded"};
+          }
+        return std::max(required, std::min(max_size(), m_capacity * 2));
+        }
+
+      /**
+       * Grow the capacity geometrically, if it is less than @p required.
+       */
+      void ensure_capacity(size_type required)
+        {
+        if(required > m_capacity)
+          {
+          reallocate(grown_capacity(required));
+          }
+        }
+
+      void construct_n(pointer target, size_type count, value_type const & value)
+        {
+        auto current = target;
+        try
+          {
+          for(; current != target + count; ++current)
+            {
+            traits::construct(m_allocator, current, value);
+            }
+          }
+        catch(...)
+          {
+          destroy(target, current);
+          throw;
+          }
+        }
+
+      void destroy(pointer first, pointer last) noexcept
+        {
+        if constexpr(!std::is_trivially_destructible<value_type>::value)
+          {
+          for(; first != last; ++first)
+            {
+            traits::destroy(m_allocator, first);
+            }
+          }
+        }
+
+      /**
+       * Move @p count elements from @p source to the uninitialized storage at @p target and destroy the originals. Elements
+       * that are not trivially relocatable are only moved if that cannot throw, and copied otherwise, so that the source
+       * remains intact if an exception is thrown.
+       */
+      void relocate(pointer source, size_type count, pointer target)
+        {
+        if constexpr(relocatable)
+          {
+          if(count)
+            {
+            std::memcpy(static_cast<void *>(target), static_cast<void const *>(source), count * sizeof(value_type));
+            }
+          }
+        else
+          {
+          auto current = size_type{};
+          try
+            {
+            for(; current < count; ++current)
+              {
+              traits::construct(m_allocator, target + current, std::move_if_noexcept(source[current]));
+              }
+            }
+          catch(...)
+            {
+            destroy(target, target + current);
+            throw;
+            }
+          destroy(source, source + count);
+          }
+        }
+
+      /**
+       * Move the elements to a buffer of the given capacity, which is the inline storage if the capacity does not exceed
+       * the inline capacity.
+       */
+      void reallocate(size_type capacity)
+        {
+        auto const use_inline = capacity <= InlineCapacity;
+        auto const target = use_inline ? inline_data() : traits::allocate(m_allocator, capacity);
+        if(target == m_data)
+          {
+          return;
+          }
+
+        try
+          {
+          relocate(m_data, m_size, target);
+          }
+        catch(...)
+          {
+          if(!use_inline)
+            {
+            traits::deallocate(m_allocator, target, capacity);
+            }
+          throw;
+          }
+
+        release();
+        m_data = target;
+        m_capacity = use_inline ? InlineCapacity : capacity;
+        }
+
+      /**
+       * Append an element to a full container. The new element is constructed before the existing elements are relocated,
+       * since the arguments might refer to one of them.
+       */
+      template<typename ...ArgumentTypes>
+      reference emplace_back_reallocating(ArgumentTypes && ...arguments)
+        {
+        auto const capacity = grown_capacity(m_size + 1);
+        auto const target = traits::allocate(m_allocator, capacity);
+
+        try
+          {
+          traits::construct(m_allocator, target + m_size, std::forward<ArgumentTypes>(arguments)...);
+          }
+        catch(...)
+          {
+          traits::deallocate(m_allocator, target, capacity);
+          throw;
+          }
+
+        try
+          {
+          relocate(m_data, m_size, target);
+          }
+        catch(...)
+          {
+          traits::destroy(m_allocator, target + m_size);
+          traits::deallocate(m_allocator, target, capacity);
+          throw;
+          }
+
+        release();
+        m_data = target;
+        m_capacity = capacity;
+        ++m_size;
+        return back();
+        }
+
+      template<typename ConstructorType>
+      void resize_with(size_type count, ConstructorType construct)
+        {
+        if(count <= m_size)
+          {
+          destroy(begin() + count, end());
+          m_size = count;
+          return;
+          }
+
+        ensure_capacity(count);
+        auto const old_size = m_size;
+        try
+          {
+          for(; m_size < count; ++m_size)
+            {
+            construct(end());
+            }
+          }
+        catch(...)
+          {
+          destroy(begin() + old_size, end());
+          m_size = old_size;
+          throw;
+          }
+        }
+
+      /**
+       * Return the heap buffer, if any, to the allocator and switch back to the inline storage. The elements must have been
+       * destroyed or relocated before.
+       */
+      void release() noexcept
+        {
+        if(!is_inline())
+          {
+          traits::deallocate(m_allocator, m_data, m_capacity);
+          m_data = inline_data();
+          m_capacity = InlineCapacity;
+          }
+        }
+
+      /**
+       * Take over the elements of another container, which must be empty or use an equal allocator, leaving it empty. This
+       * container must be empty and must not own a heap buffer.
+       */
+      void take(small_vector & other) noexcept(std::is_nothrow_move_constructible<value_type>::value)
+        {
+        if(other.is_inline())
+          {
+          relocate(other.m_data, other.m_size, inline_data());
+          m_size = std::exchange(other.m_size, 0);
+          }
+        else
+          {
+          m_data = std::exchange(other.m_data, other.inline_data());
+          m_size = std::exchange(other.m_size, 0);
+          m_capacity = std::exchange(other.m_capacity, InlineCapacity);
+          }
+        }
+
+      AllocatorType m_allocator;
+      pointer m_data{inline_data()};
+      size_type m_size{};
+      size_type m_capacity{InlineCapacity};
+      alignas(value_type) unsigned char m_inline[InlineCapacity * sizeof(value_type)];
+    };
+
+  template<typename ValueType, std::size_t InlineCapacity, typename AllocatorType>
+  bool operator==(small_vector<ValueType, InlineCapacity, AllocatorType> const & lhs,
+                  small_vector<ValueType, InlineCapacity, AllocatorType> const & rhs)
+    {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+  template<typename ValueType, std::size_t InlineCapacity, typename AllocatorType>
+  bool operator!=(small_vector<ValueType, InlineCapacity, AllocatorType> const & lhs,
+                  small_vector<ValueType, InlineCapacity, AllocatorType> const & rhs)
+    {
+    return !(lhs == rhs);
+    }
+
+  template<typename ValueType, std::size_t InlineCapacity, typename AllocatorType>
+  bool operator<(small_vector<ValueType, InlineCapacity, AllocatorType> const & lhs,
+                 small_vector<ValueType, InlineCapacity, AllocatorType> const & rhs)
+    {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+  template<typename ValueType, std::size_t InlineCapacity, typename AllocatorType>
+  bool operator>(small_vector<ValueType, InlineCapacity, AllocatorType> const & lhs,
+                 small_vector<ValueType, InlineCapacity, AllocatorType> const & rhs)
+    {
+    return rhs < lhs;
+    }
+
+  template<typename ValueType, std::size_t InlineCapacity, typename AllocatorType>
+  bool operator<=(small_vector<ValueType, InlineCapacity, AllocatorType> const & lhs,
+                  small_vector<ValueType, InlineCapacity, AllocatorType> const & rhs)
+    {
+    return !(rhs < lhs);
+    }
+
+  template<typename ValueType, std::size_t InlineCapacity, typename AllocatorType>
+  bool operator>=(small_vector<ValueType, InlineCapacity, AllocatorType> const & lhs,
+                  small_vector<ValueType, InlineCapacity, AllocatorType> const & rhs)
+    {
+    return !(lhs < rhs);
+    }
+
+  template<typename ValueType, std::size_t InlineCapacity, typename AllocatorType>
+  void swap(small_vector<ValueType, InlineCapacity, AllocatorType> & lhs,
+            small_vector<ValueType, InlineCapacity, AllocatorType> & rhs)
+    {
+    lhs.swap(rhs);
+    }
+
+  }
+
+#endif
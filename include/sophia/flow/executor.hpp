@@ -0,0 +1,943 @@
+#ifndef SOPHIA_FLOW__EXECUTOR
+#define SOPHIA_FLOW__EXECUTOR
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#if defined(__SANITIZE_THREAD__)
+#define SOPHIA_FLOW_THREAD_SANITIZER
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define SOPHIA_FLOW_THREAD_SANITIZER
+#endif
+#endif
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace sophia::flow
+  {
+
+  namespace internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief A unit of work that can be scheduled on an #sophia::flow::executor
+     *
+     * Tasks are heap allocated when they are spawned, and delete themselves once they have been executed.
+     */
+    struct task
+      {
+      virtual ~task() = default;
+
+      /**
+       * @internal
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Execute the task and destroy it
+       */
+      virtual void execute() = 0;
+      };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief A Chase-Lev work-stealing deque of tasks
+     *
+     * The owning worker pushes and pops tasks at the bottom of the deque, while other threads steal tasks from its top. The
+     * deque grows as needed. Buffers that were replaced by a larger one are kept alive until the deque is destroyed, since
+     * a concurrent thief might still be reading from them.
+     *
+     * The implementation follows "Correct and Efficient Work-Stealing for Weak Memory Models" by Lê et al., but uses
+     * sequentially consistent operations instead of stand-alone fences, so that it can be checked by ThreadSanitizer.
+     */
+    struct work_deque
+      {
+      explicit work_deque(std::int64_t capacity = 256)
+        {
+        m_rings.push_back(std::make_unique<ring>(capacity));
+        m_ring.store(m_rings.back().get(), std::memory_order_relaxed);
+        }
+
+      work_deque(work_deque const &) = delete;
+      work_deque & operator=(work_deque const &) = delete;
+
+      /**
+       * @internal
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Push a task onto the bottom of the deque. May only be called by the owning worker.
+       */
+      void push(task * item)
+        {
+        auto const bottom = m_bottom.load(std::memory_order_relaxed);
+        auto const top = m_top.load(std::memory_order_acquire);
+        auto buffer = m_ring.load(std::memory_order_relaxed);
+
+        if(bottom - top > buffer->mask)
+          {
+          buffer = grow(buffer, top, bottom);
+          }
+
+        buffer->put(bottom, item);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+        }
+
+      /**
+       * @internal
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Pop a task from the bottom of the deque. May only be called by the owning worker.
+       *
+       * @return The most recently pushed task, or @p nullptr if the deque is empty
+       */
+      task * pop()
+        {
+        auto const bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        auto const buffer = m_ring.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_seq_cst);
+        auto top = m_top.load(std::memory_order_seq_cst);
+
+        if(top > bottom)
+          {
+          m_bottom.store(bottom + 1, std::memory_order_release);
+          return nullptr;
+          }
+
+        auto item = buffer->get(bottom);
+        if(top == bottom)
+          {
+          if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+            item = nullptr;
+            }
+          m_bottom.store(bottom + 1, std::memory_order_release);
+          }
+        return item;
+        }
+
+      /**
+       * @internal
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Steal a task from the top of the deque. May be called by any thread.
+       *
+       * @return The least recently pushed task, or @p nullptr if the deque is empty or the steal lost a race
+       */
+      task * steal()
+        {
+        auto top = m_top.load(std::memory_order_seq_cst);
+        auto const bottom = m_bottom.load(std::memory_order_seq_cst);
+
+        if(top >= bottom)
+          {
+          return nullptr;
+          }
+
+        auto const item = m_ring.load(std::memory_order_acquire)->get(top);
+        if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+          {
+          return nullptr;
+          }
+        return item;
+        }
+
+      /**
+       * @internal
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Check whether the deque appears to be empty
+       */
+      bool empty() const
+        {
+        return m_top.load(std::memory_order_seq_cst) >= m_bottom.load(std::memory_order_seq_cst);
+        }
+
+      private:
+        struct ring
+          {
+          explicit ring(std::int64_t capacity)
+            : mask{capacity - 1},
+              slots{std::make_unique<std::atomic<task *>[]>(static_cast<std::size_t>(capacity))}
+            {
+
+            }
+
+          task * get(std::int64_t index) const
+            {
+            return slots[static_cast<std::size_t>(index & mask)].load(std::memory_order_relaxed);
+            }
+
+          void put(std::int64_t index, task * item)
+            {
+            slots[static_cast<std::size_t>(index & mask)].store(item, std::memory_order_relaxed);
+            }
+
+          std::int64_t const mask;
+          std::unique_ptr<std::atomic<task *>[]> const slots;
+          };
+
+        ring * grow(ring * current, std::int64_t top, std::int64_t bottom)
+          {
+          m_rings.push_back(std::make_unique<ring>((current->mask + 1) * 2));
+          auto const grown = m_rings.back().get();
+          for(auto index = top; index < bottom; ++index)
+            {
+            grown->put(index, current->get(index));
+            }
+          m_ring.store(grown, std::memory_order_release);
+          return grown;
+          }
+
+        alignas(64) std::atomic<std::int64_t> m_top{};
+        alignas(64) std::atomic<std::int64_t> m_bottom{};
+        std::atomic<ring *> m_ring{};
+        std::vector<std::unique_ptr<ring>> m_rings{};
+      };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Wait a little before retrying to find work
+     *
+     * The first rounds spin for an exponentially growing number of pause instructions, later rounds yield the processor.
+     */
+    inline void backoff(std::size_t round)
+      {
+      constexpr auto spin_rounds = std::size_t{8};
+
+      if(round < spin_rounds)
+        {
+        for(auto spin = 0ull; spin < (1ull << round); ++spin)
+          {
+#if defined(__x86_64__) || defined(__i386__)
+          _mm_pause();
+#endif
+          }
+        }
+      else
+        {
+        std::this_thread::yield();
+        }
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief A cheap per-thread pseudo random number generator used for victim selection
+     */
+    inline std::uint64_t random()
+      {
+      thread_local std::uint64_t state = std::uint64_t{0x9e3779b97f4a7c15} ^ reinterpret_cast<std::uintptr_t>(&state);
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      return state;
+      }
+
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A pool of worker threads executing tasks using work-stealing
+   *
+   * Each worker owns a Chase-Lev deque. Tasks spawned on a worker are pushed onto its own deque and executed in LIFO
+   * order, which keeps fork-join workloads cache friendly, while idle workers steal the oldest tasks of other workers.
+   * Tasks spawned on other threads are placed in a shared injection queue. Idle workers spin for a short while and then go
+   * to sleep until new work is scheduled.
+   *
+   * Tasks are submitted via #sophia::flow::task_group or #sophia::flow::parallel_for. A thread waiting for a task group
+   * helps executing tasks in the meantime.
+   */
+  struct executor
+    {
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Create a new executor and start its workers
+     *
+     * @param workers The number of worker threads. Zero selects one less than the number of hardware threads, since the
+     * thread waiting for the results participates in the computation.
+     * @param pin_workers Whether to pin each worker to a single core. Pinning is only supported on Linux and ignored
+     * elsewhere.
+     */
+    explicit executor(std::size_t workers = 0, bool pin_workers = false)
+      {
+      if(!workers)
+        {
+        workers = std::max(2u, std::thread::hardware_concurrency()) - 1;
+        }
+
+      auto const cores = pin_workers ? available_cores() : std::vector<int>{};
+
+      m_workers.reserve(workers);
+      for(auto index = 0ull; index < workers; ++index)
+        {
+        m_workers.push_back(std::make_unique<worker>());
+        }
+
+      try
+        {
+        for(auto index = 0ull; index < workers; ++index)
+          {
+          auto const core = cores.empty() ? -1 : cores[index % cores.size()];
+          m_workers[index]->thread = std::thread{[this, index, core]{ run(index, core); }};
+          }
+        }
+      catch(...)
+        {
+        stop();
+        throw;
+        }
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Stop and join all workers
+     *
+     * All task groups using the executor must have been waited for before it is destroyed.
+     */
+    ~executor()
+      {
+      stop();
+      }
+
+    executor(executor const &) = delete;
+    executor & operator=(executor const &) = delete;
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Access the process-wide executor
+     *
+     * The shared executor is created on first use with the default number of workers.
+     */
+    static executor & shared()
+      {
+      static auto instance = executor{};
+      return instance;
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Get the number of worker threads
+     */
+    std::size_t concurrency() const noexcept
+      {
+      return m_workers.size();
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Schedule a task for execution
+     *
+     * The executor takes ownership of the task.
+     */
+    void schedule(internal::task * task)
+      {
+      auto const & context = current();
+      if(context.owner == this)
+        {
+        m_workers[context.index]->deque.push(task);
+        }
+      else
+        {
+        auto lock = std::lock_guard<std::mutex>{m_injection_mutex};
+        m_injected.push_back(task);
+        m_injected_count.store(m_injected.size(), std::memory_order_relaxed);
+        }
+      notify();
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Execute a single pending task on the calling thread, if there is one
+     *
+     * @return @p true iff a task was executed
+     */
+    bool run_pending()
+      {
+      auto const & context = current();
+      auto const task = find_task(context.owner == this ? context.index : m_workers.size());
+      if(task)
+        {
+        task->execute();
+        }
+      return task;
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Check whether the calling thread is one of the workers of this executor
+     */
+    bool is_worker() const noexcept
+      {
+      return current().owner == this;
+      }
+
+    private:
+      struct worker
+        {
+        internal::work_deque deque{};
+        std::thread thread{};
+        };
+
+      struct worker_context
+        {
+        executor const * owner;
+        std::size_t index;
+        };
+
+      static worker_context & current()
+        {
+        thread_local auto context = worker_context{nullptr, 0};
+        return context;
+        }
+
+      static std::vector<int> available_cores()
+        {
+        auto cores = std::vector<int>{};
+#if defined(__linux__)
+        auto set = cpu_set_t{};
+        if(!sched_getaffinity(0, sizeof(set), &set))
+          {
+          for(auto core = 0; core < CPU_SETSIZE; ++core)
+            {
+            if(CPU_ISSET(core, &set))
+              {
+              cores.push_back(core);
+              }
+            }
+          }
+#endif
+        return cores;
+        }
+
+      static void pin(int core)
+        {
+#if defined(__linux__)
+        if(core >= 0)
+          {
+          auto set = cpu_set_t{};
+          CPU_ZERO(&set);
+          CPU_SET(core, &set);
+          pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+          }
+#else
+        static_cast<void>(core);
+#endif
+        }
+
+      /**
+       * Find a task to execute, looking at the deque of the given worker first, then at the injection queue and finally
+       * at the deques of the other workers, starting at a random victim. An index of @p concurrency() denotes a thread that
+       * is not a worker of this executor.
+       */
+      internal::task * find_task(std::size_t self)
+        {
+        if(self < m_workers.size())
+          {
+          if(auto task = m_workers[self]->deque.pop())
+            {
+            return task;
+            }
+          }
+
+        if(m_injected_count.load(std::memory_order_relaxed))
+          {
+          auto lock = std::lock_guard<std::mutex>{m_injection_mutex};
+          if(!m_injected.empty())
+            {
+            auto task = m_injected.front();
+            m_injected.pop_front();
+            m_injected_count.store(m_injected.size(), std::memory_order_relaxed);
+            return task;
+            }
+          }
+
+        auto const count = m_workers.size();
+        auto const start = internal::random() % count;
+        for(auto offset = 0ull; offset < count; ++offset)
+          {
+          auto const victim = (start + offset) % count;
+          if(victim == self)
+            {
+            continue;
+            }
+
+          if(auto task = m_workers[victim]->deque.steal())
+            {
+            return task;
+            }
+          }
+
+        return nullptr;
+        }
+
+      /**
+       * Wake a sleeping worker, if there is one. The fence pairs with the increment of the sleeper count in @p idle, so
+       * that either the scheduling thread sees the sleeper, or the sleeper sees the newly scheduled task. ThreadSanitizer
+       * does not support stand-alone fences, so sanitized builds use an equivalent read-modify-write of the sleeper count
+       * instead. Pending wake-up signals are capped at the number of sleeping workers.
+       */
+      void notify()
+        {
+#if defined(SOPHIA_FLOW_THREAD_SANITIZER)
+        if(m_sleeping.fetch_add(0, std::memory_order_seq_cst))
+#else
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(m_sleeping.load(std::memory_order_relaxed))
+#endif
+          {
+            {
+            auto lock = std::lock_guard<std::mutex>{m_sleep_mutex};
+            m_signals = std::min(m_signals + 1, m_sleeping.load(std::memory_order_relaxed));
+            }
+          m_wakeup.notify_one();
+          }
+        }
+
+      /**
+       * Put the calling worker to sleep until new work is scheduled or the executor is stopped.
+       */
+      void idle()
+        {
+        m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+
+        auto const pending = [&]{
+          for(auto const & worker : m_workers)
+            {
+            if(!worker->deque.empty())
+              {
+              return true;
+              }
+            }
+          return m_injected_count.load(std::memory_order_seq_cst) > 0;
+        };
+
+        if(!pending())
+          {
+          auto lock = std::unique_lock<std::mutex>{m_sleep_mutex};
+          m_wakeup.wait(lock, [&]{ return m_signals || m_stopping.load(std::memory_order_relaxed); });
+          if(m_signals)
+            {
+            --m_signals;
+            }
+          }
+
+        m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+      /**
+       * Stop all workers and join those that were started. If a worker thread could not be created, the constructor calls
+       * this function before rethrowing, since the destructor does not run in that case.
+       */
+      void stop()
+        {
+          {
+          auto lock = std::lock_guard<std::mutex>{m_sleep_mutex};
+          m_stopping.store(true, std::memory_order_relaxed);
+          }
+        m_wakeup.notify_all();
+
+        for(auto & worker : m_workers)
+          {
+          if(worker->thread.joinable())
+            {
+            worker->thread.join();
+            }
+          }
+        }
+
+      void run(std::size_t self, int core)
+        {
+        constexpr auto idle_rounds = std::size_t{16};
+
+        current() = worker_context{this, self};
+        pin(core);
+
+        auto round = std::size_t{};
+        while(!m_stopping.load(std::memory_order_relaxed))
+          {
+          if(auto task = find_task(self))
+            {
+            task->execute();
+            round = 0;
+            }
+          else if(round < idle_rounds)
+            {
+            internal::backoff(round++);
+            }
+          else
+            {
+            idle();
+            round = 0;
+            }
+          }
+        }
+
+      std::vector<std::unique_ptr<worker>> m_workers{};
+
+      std::mutex m_injection_mutex{};
+      std::deque<internal::task *> m_injected{};
+      std::atomic<std::size_t> m_injected_count{};
+
+      std::mutex m_sleep_mutex{};
+      std::condition_variable m_wakeup{};
+      std::size_t m_signals{};
+      std::atomic<std::size_t> m_sleeping{};
+      std::atomic<bool> m_stopping{};
+    };
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A group of tasks that can be waited for as a whole
+   *
+   * Tasks can be spawned from any thread, including from within other tasks of the same group. The first exception thrown
+   * by a task of the group is rethrown by #wait.
+   *
+   * @par Example:
+   * @rst
+   * .. code-block:: c++
+   *    :linenos:
+   *
+   *    #include <sophia/flow/executor.hpp>
+   *
+   *    long fibonacci(long n)
+   *      {
+   *      if(n < 2)
+   *        {
+   *        return n;
+   *        }
+   *
+   *      auto group = sophia::flow::task_group{};
+   *      auto first = 0l;
+   *      group.run([&]{ first = fibonacci(n - 1); });
+   *      auto const second = fibonacci(n - 2);
+   *      group.wait();
+   *      return first + second;
+   *      }
+   * @endrst
+   */
+  struct task_group
+    {
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Create a new task group scheduling its tasks on the given executor
+     */
+    explicit task_group(executor & executor = executor::shared())
+      : m_executor{executor}
+      {
+
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Wait for all tasks of the group, discarding any exception they might have thrown
+     */
+    ~task_group()
+      {
+      drain();
+      }
+
+    task_group(task_group const &) = delete;
+    task_group & operator=(task_group const &) = delete;
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Spawn a task executing the given function
+     */
+    template<typename FunctionType>
+    void run(FunctionType && function)
+      {
+      using task_type = group_task<std::decay_t<FunctionType>>;
+      auto task = std::make_unique<task_type>(std::forward<FunctionType>(function), *this);
+      m_pending.fetch_add(1, std::memory_order_relaxed);
+      m_executor.schedule(task.release());
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Wait for all tasks of the group to finish
+     *
+     * The calling thread executes pending tasks while waiting. If no task is runnable, a worker of the executor keeps looking
+     * for work, while any other thread goes to sleep until the last task of the group has finished. If any task threw an
+     * exception, the first such exception is rethrown once all tasks have finished.
+     */
+    void wait()
+      {
+      drain();
+
+      if(m_failed.load(std::memory_order_relaxed))
+        {
+        auto exception = std::exception_ptr{};
+        std::swap(exception, m_exception);
+        m_failed.store(false, std::memory_order_relaxed);
+        std::rethrow_exception(exception);
+        }
+      }
+
+    private:
+      template<typename FunctionType>
+      struct group_task : internal::task
+        {
+        template<typename ArgumentType>
+        group_task(ArgumentType && function, task_group & group)
+          : m_function{std::forward<ArgumentType>(function)},
+            m_group{group}
+          {
+
+          }
+
+        void execute() override
+          {
+          auto & group = m_group;
+          try
+            {
+            std::invoke(m_function);
+            }
+          catch(...)
+            {
+            group.fail(std::current_exception());
+            }
+          delete this;
+          group.finish();
+          }
+
+        FunctionType m_function;
+        task_group & m_group;
+        };
+
+      void fail(std::exception_ptr exception)
+        {
+        auto lock = std::lock_guard<std::mutex>{m_mutex};
+        if(!m_failed.load(std::memory_order_relaxed))
+          {
+          m_exception = std::move(exception);
+          m_failed.store(true, std::memory_order_relaxed);
+          }
+        }
+
+      /**
+       * Mark a task of the group as finished. The count only drops to zero while the mutex is held, so that a thread
+       * sleeping in @p drain cannot miss the wake-up. This is the last access of a task to its group.
+       */
+      void finish()
+        {
+        auto pending = m_pending.load(std::memory_order_relaxed);
+        while(pending > 1)
+          {
+          if(m_pending.compare_exchange_weak(pending, pending - 1, std::memory_order_release, std::memory_order_relaxed))
+            {
+            return;
+            }
+          }
+
+        auto lock = std::lock_guard<std::mutex>{m_mutex};
+        m_pending.fetch_sub(1, std::memory_order_release);
+        m_finished.notify_all();
+        }
+
+      /**
+       * Wait for the pending count to drop to zero, executing pending tasks meanwhile. Threads that are not workers of the
+       * executor go to sleep after a bounded number of unsuccessful rounds. Before returning, the mutex is acquired once, so
+       * that the task that finished last is done with the group before it can be destroyed.
+       */
+      void drain()
+        {
+        constexpr auto idle_rounds = std::size_t{16};
+
+        auto const worker = m_executor.is_worker();
+        auto round = std::size_t{};
+        while(m_pending.load(std::memory_order_acquire))
+          {
+          if(m_executor.run_pending())
+            {
+            round = 0;
+            }
+          else if(worker || round < idle_rounds)
+            {
+            internal::backoff(round++);
+            }
+          else
+            {
+            auto lock = std::unique_lock<std::mutex>{m_mutex};
+            m_finished.wait(lock, [&]{ return !m_pending.load(std::memory_order_acquire); });
+            }
+          }
+
+        auto const lock = std::lock_guard<std::mutex>{m_mutex};
+        }
+
+      executor & m_executor;
+      std::atomic<std::size_t> m_pending{};
+      std::atomic<bool> m_failed{};
+      std::mutex m_mutex{};
+      std::condition_variable m_finished{};
+      std::exception_ptr m_exception{};
+    };
+
+  namespace internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Recursively split [first, last) in halves, spawning a task for each upper half, until the range is no larger
+     * than the grain size
+     */
+    template<typename IndexType, typename FunctionType>
+    void split_range(task_group & group, IndexType first, IndexType last, std::size_t grain, FunctionType & body)
+      {
+      while(static_cast<std::size_t>(last - first) > grain)
+        {
+        auto const middle = first + (last - first) / 2;
+        group.run([&group, &body, middle, last, grain]{ split_range(group, middle, last, grain, body); });
+        last = middle;
+        }
+
+      for(; first != last; ++first)
+        {
+        std::invoke(body, first);
+        }
+      }
+
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Invoke a function for every index in [first, last) in parallel on the given executor
+   *
+   * The range is split recursively until the chunks contain at most @p grain indices. The calling thread participates in
+   * the computation and returns once all indices have been processed.
+   *
+   * @param executor The executor to run on
+   * @param first The first index
+   * @param last The index one past the last index
+   * @param body The function to invoke with every index
+   * @param grain The maximum number of indices processed by a single task. Zero selects a grain that yields about eight
+   * tasks per thread.
+   */
+  template<typename IndexType,
+           typename FunctionType,
+           typename = std::enable_if_t<std::is_integral<IndexType>::value>>
+  void parallel_for(executor & executor, IndexType first, IndexType last, FunctionType && body, std::size_t grain = 0)
+    {
+    if(last <= first)
+      {
+      return;
+      }
+
+    if(!grain)
+      {
+      auto const count = static_cast<std::size_t>(last - first);
+      grain = std::max(std::size_t{1}, count / (8 * (executor.concurrency() + 1)));
+      }
+
+    auto group = task_group{executor};
+    internal::split_range(group, first, last, grain, body);
+    group.wait();
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Invoke a function for every index in [first, last) in parallel on the shared executor
+   *
+   * @par Example:
+   * @rst
+   * .. code-block:: c++
+   *    :linenos:
+   *
+   *    #include <sophia/flow/executor.hpp>
+   *
+   *    #include <vector>
+   *
+   *    int main()
+   *      {
+   *      auto values = std::vector<double>(1 << 20);
+   *      sophia::flow::parallel_for(0ul, values.size(), [&](auto index){ values[index] = index * 0.5; });
+   *      }
+   * @endrst
+   *
+   * @see #sophia::flow::parallel_for(executor &, IndexType, IndexType, FunctionType &&, std::size_t)
+   */
+  template<typename IndexType,
+           typename FunctionType,
+           typename = std::enable_if_t<std::is_integral<IndexType>::value>>
+  void parallel_for(IndexType first, IndexType last, FunctionType && body, std::size_t grain = 0)
+    {
+    parallel_for(executor::shared(), first, last, std::forward<FunctionType>(body), grain);
+    }
+
+  }
+
+#endif
@@ -13,6 +13,8 @@
  * @defgroup sophia_flow Flow Control
  */
 
+#include "executor.hpp"
+#include "generator.hpp"
 #include "guard.hpp"
 
 #endif
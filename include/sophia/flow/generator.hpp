@@ -0,0 +1,710 @@
+#ifndef SOPHIA_FLOW__GENERATOR
+#define SOPHIA_FLOW__GENERATOR
+
+#include "sophia/string/format.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sophia::flow
+  {
+
+  namespace internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief An input iterator over the elements of a generator
+     *
+     * The iterator only holds a pointer to the generator. Advancing the iterator advances the generator itself, so a
+     * generator can only be iterated once.
+     */
+    template<typename GeneratorType>
+    struct generator_iterator
+      {
+      using iterator_category = std::input_iterator_tag;
+      using value_type = typename GeneratorType::value_type;
+      using difference_type = std::ptrdiff_t;
+      using pointer = value_type const *;
+      using reference = decltype(std::declval<GeneratorType &>().value());
+
+      reference operator*() const
+        {
+        return m_generator->value();
+        }
+
+      generator_iterator & operator++()
+        {
+        if(!m_generator->next())
+          {
+          m_generator = nullptr;
+          }
+        return *this;
+        }
+
+      void operator++(int)
+        {
+        ++*this;
+        }
+
+      bool operator==(generator_iterator const & other) const
+        {
+        return m_generator == other.m_generator;
+        }
+
+      bool operator!=(generator_iterator const & other) const
+        {
+        return !(*this == other);
+        }
+
+      GeneratorType * m_generator;
+      };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief The common base of all generators
+     *
+     * Every generator provides the member functions @p next(), which advances it to its next element and returns @p false
+     * if it is exhausted, and @p value(), which accesses the current element. This base adds support for range-based for
+     * loops on top of that interface.
+     */
+    template<typename Derived>
+    struct generator_base
+      {
+      generator_iterator<Derived> begin()
+        {
+        auto iterator = generator_iterator<Derived>{static_cast<Derived *>(this)};
+        return ++iterator;
+        }
+
+      generator_iterator<Derived> end()
+        {
+        return {nullptr};
+        }
+      };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief The element type of a generator, with references and cv-qualification removed
+     */
+    template<typename GeneratorType>
+    using element_t = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<GeneratorType &>().value())>>;
+
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A generator producing the elements of a range
+   *
+   * @see #sophia::flow::from
+   */
+  template<typename IteratorType>
+  struct range_generator : internal::generator_base<range_generator<IteratorType>>
+    {
+    using value_type = typename std::iterator_traits<IteratorType>::value_type;
+
+    range_generator(IteratorType first, IteratorType last)
+      : m_current{first},
+        m_last{last}
+      {
+
+      }
+
+    bool next()
+      {
+      if(m_started && m_current != m_last)
+        {
+        ++m_current;
+        }
+      m_started = true;
+      return m_current != m_last;
+      }
+
+    decltype(auto) value()
+      {
+      return *m_current;
+      }
+
+    private:
+      IteratorType m_current;
+      IteratorType m_last;
+      bool m_started{};
+    };
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A generator producing the values returned by a function
+   *
+   * @see #sophia::flow::generate
+   */
+  template<typename FunctionType>
+  struct function_generator : internal::generator_base<function_generator<FunctionType>>
+    {
+    using value_type = typename std::invoke_result_t<FunctionType &>::value_type;
+
+    explicit function_generator(FunctionType function)
+      : m_function{std::move(function)}
+      {
+
+      }
+
+    bool next()
+      {
+      m_current = std::invoke(m_function);
+      return m_current.has_value();
+      }
+
+    value_type & value()
+      {
+      return *m_current;
+      }
+
+    private:
+      FunctionType m_function;
+      std::optional<value_type> m_current{};
+    };
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A generator producing an unbounded sequence of incrementing values
+   *
+   * @see #sophia::flow::iota
+   */
+  template<typename ValueType>
+  struct iota_generator : internal::generator_base<iota_generator<ValueType>>
+    {
+    using value_type = ValueType;
+
+    explicit iota_generator(ValueType first)
+      : m_current{std::move(first)}
+      {
+
+      }
+
+    bool next()
+      {
+      if(m_started)
+        {
+        ++m_current;
+        }
+      m_started = true;
+      return true;
+      }
+
+    value_type const & value() const
+      {
+      return m_current;
+      }
+
+    private:
+      ValueType m_current;
+      bool m_started{};
+    };
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A generator applying a function to every element of another generator
+   *
+   * @see #sophia::flow::map
+   */
+  template<typename SourceType, typename FunctionType>
+  struct map_generator : internal::generator_base<map_generator<SourceType, FunctionType>>
+    {
+    using value_type = std::decay_t<std::invoke_result_t<FunctionType &, decltype(std::declval<SourceType &>().value())>>;
+
+    map_generator(SourceType source, FunctionType function)
+      : m_source{std::move(source)},
+        m_function{std::move(function)}
+      {
+
+      }
+
+    bool next()
+      {
+      if(!m_source.next())
+        {
+        return false;
+        }
+      m_current.emplace(std::invoke(m_function, m_source.value()));
+      return true;
+      }
+
+    value_type & value()
+      {
+      return *m_current;
+      }
+
+    private:
+      SourceType m_source;
+      FunctionType m_function;
+      std::optional<value_type> m_current{};
+    };
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A generator skipping the elements of another generator that do not satisfy a predicate
+   *
+   * @see #sophia::flow::filter
+   */
+  template<typename SourceType, typename PredicateType>
+  struct filter_generator : internal::generator_base<filter_generator<SourceType, PredicateType>>
+    {
+    using value_type = internal::element_t<SourceType>;
+
+    filter_generator(SourceType source, PredicateType predicate)
+      : m_source{std::move(source)},
+        m_predicate{std::move(predicate)}
+      {
+
+      }
+
+    bool next()
+      {
+      while(m_source.next())
+        {
+        if(std::invoke(m_predicate, std::as_const(m_source.value())))
+          {
+          return true;
+          }
+        }
+      return false;
+      }
+
+    decltype(auto) value()
+      {
+      return m_source.value();
+      }
+
+    private:
+      SourceType m_source;
+      PredicateType m_predicate;
+    };
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A generator producing at most a given number of elements of another generator
+   *
+   * @see #sophia::flow::take
+   */
+  template<typename SourceType>
+  struct take_generator : internal::generator_base<take_generator<SourceType>>
+    {
+    using value_type = internal::element_t<SourceType>;
+
+    take_generator(SourceType source, std::size_t count)
+      : m_source{std::move(source)},
+        m_remaining{count}
+      {
+
+      }
+
+    bool next()
+      {
+      if(!m_remaining)
+        {
+        return false;
+        }
+      --m_remaining;
+      return m_source.next();
+      }
+
+    decltype(auto) value()
+      {
+      return m_source.value();
+      }
+
+    private:
+      SourceType m_source;
+      std::size_t m_remaining;
+    };
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A view of a chunk of elements produced by #sophia::flow::chunk
+   *
+   * The view refers to the internal buffer of the chunking generator and is invalidated when the generator is advanced.
+   */
+  template<typename ValueType>
+  struct chunk_view
+    {
+    using value_type = ValueType;
+    using const_iterator = ValueType const *;
+
+    const_iterator begin() const
+      {
+      return m_first;
+      }
+
+    const_iterator end() const
+      {
+      return m_last;
+      }
+
+    std::size_t size() const
+      {
+      return static_cast<std::size_t>(m_last - m_first);
+      }
+
+    ValueType const & operator[](std::size_t index) const
+      {
+      return m_first[index];
+      }
+
+    ValueType const * m_first;
+    ValueType const * m_last;
+    };
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Write a chunk to a stream
+   *
+   * The elements are formatted like #sophia::string::format formats them, separated by commas and enclosed in brackets. They
+   * are written to the stream one by one, without staging the chunk in a string.
+   */
+  template<typename ValueType>
+  std::ostream & operator<<(std::ostream & stream, chunk_view<ValueType> const & chunk)
+    {
+    stream.put('[');
+    for(auto index = 0ull; index < chunk.size(); ++index)
+      {
+      if(index)
+        {
+        stream.write(", ", 2);
+        }
+      string::internal::write_formatted(stream, chunk[index]);
+      }
+    return stream.put(']');
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A generator grouping the elements of another generator into chunks of a fixed size
+   *
+   * The elements are copied into a buffer that is allocated once, when the generator is created. The last chunk may be
+   * smaller than the requested size.
+   *
+   * @see #sophia::flow::chunk
+   */
+  template<typename SourceType>
+  struct chunk_generator : internal::generator_base<chunk_generator<SourceType>>
+    {
+    using element_type = internal::element_t<SourceType>;
+    using value_type = chunk_view<element_type>;
+
+    chunk_generator(SourceType source, std::size_t size)
+      : m_source{std::move(source)},
+        m_size{size ? size : 1}
+      {
+      m_buffer.reserve(m_size);
+      }
+
+    bool next()
+      {
+      m_buffer.clear();
+      while(m_buffer.size() < m_size && m_source.next())
+        {
+        m_buffer.push_back(m_source.value());
+        }
+      return !m_buffer.empty();
+      }
+
+    value_type value() const
+      {
+      return {m_buffer.data(), m_buffer.data() + m_buffer.size()};
+      }
+
+    private:
+      SourceType m_source;
+      std::size_t m_size;
+      std::vector<element_type> m_buffer{};
+    };
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Create a generator producing the elements of a range
+   *
+   * The range is not copied and must outlive the generator.
+   */
+  template<typename RangeType>
+  auto from(RangeType & range)
+    {
+    using std::begin;
+    using std::end;
+    return range_generator<decltype(begin(range))>{begin(range), end(range)};
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Create a generator producing the values returned by a function
+   *
+   * The function is called once per element and must return a @p std::optional. The generator is exhausted as soon as the
+   * function returns an empty optional.
+   */
+  template<typename FunctionType>
+  auto generate(FunctionType function)
+    {
+    return function_generator<FunctionType>{std::move(function)};
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Create a generator producing an unbounded sequence of incrementing values, starting at @p first
+   */
+  template<typename ValueType>
+  auto iota(ValueType first)
+    {
+    return iota_generator<ValueType>{std::move(first)};
+    }
+
+  namespace internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief A pipeline stage that has not been attached to a source yet
+     *
+     * Stages are attached to a source via @p operator|, which invokes the contained factory with the source.
+     */
+    template<typename FactoryType>
+    struct stage
+      {
+      FactoryType factory;
+      };
+
+    template<typename FactoryType>
+    stage(FactoryType) -> stage<FactoryType>;
+
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Attach a pipeline stage to a generator
+   */
+  template<typename SourceType, typename FactoryType>
+  auto operator|(SourceType source, internal::stage<FactoryType> stage)
+    {
+    return std::move(stage.factory)(std::move(source));
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Create a pipeline stage applying a function to every element
+   */
+  template<typename FunctionType>
+  auto map(FunctionType function)
+    {
+    return internal::stage{[function = std::move(function)](auto source) mutable {
+      return map_generator<decltype(source), FunctionType>{std::move(source), std::move(function)};
+    }};
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Create a pipeline stage skipping the elements that do not satisfy a predicate
+   */
+  template<typename PredicateType>
+  auto filter(PredicateType predicate)
+    {
+    return internal::stage{[predicate = std::move(predicate)](auto source) mutable {
+      return filter_generator<decltype(source), PredicateType>{std::move(source), std::move(predicate)};
+    }};
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Create a pipeline stage producing at most @p count elements
+   */
+  inline auto take(std::size_t count)
+    {
+    return internal::stage{[count](auto source){
+      return take_generator<decltype(source)>{std::move(source), count};
+    }};
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Create a pipeline stage grouping the elements into chunks of @p size elements
+   */
+  inline auto chunk(std::size_t size)
+    {
+    return internal::stage{[size](auto source){
+      return chunk_generator<decltype(source)>{std::move(source), size};
+    }};
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Append all elements of a generator to a string
+   *
+   * The elements are formatted like #sophia::string::format formats them, and each element is followed by @p separator.
+   *
+   * @par Example:
+   * @rst
+   * .. code-block:: c++
+   *    :linenos:
+   *
+   *    #include <sophia/flow/generator.hpp>
+   *
+   *    #include <string>
+   *
+   *    int main()
+   *      {
+   *      using namespace sophia::flow;
+   *
+   *      auto squares = iota(1) | map([](int n){ return n * n; }) | filter([](int n){ return n % 2; }) | take(5);
+   *      auto text = std::string{};
+   *      drain(squares, text, ", ");
+   *      }
+   * @endrst
+   *
+   * @return The number of elements drained
+   */
+  template<typename GeneratorType>
+  std::size_t drain(GeneratorType && generator, std::string & sink, std::string_view separator = "\n")
+    {
+    auto count = std::size_t{};
+    while(generator.next())
+      {
+      string::format_to(sink, "{0}", generator.value());
+      sink.append(separator);
+      ++count;
+      }
+    return count;
+    }
+
+  /**
+   * @ingroup sophia_flow
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Write all elements of a generator to a stream
+   *
+   * The elements are formatted like #sophia::string::format formats them, and each element is followed by @p separator.
+   * The output is staged in a buffer of bounded size, which is written to the stream whenever it fills up, so the memory
+   * used does not depend on the number of elements.
+   *
+   * @par Example:
+   * @rst
+   * .. code-block:: c++
+   *    :linenos:
+   *
+   *    #include <sophia/flow/generator.hpp>
+   *
+   *    #include <iostream>
+   *
+   *    int main()
+   *      {
+   *      using namespace sophia::flow;
+   *
+   *      auto squares = iota(1) | map([](int n){ return n * n; }) | filter([](int n){ return n % 2; }) | take(5);
+   *      drain(squares, std::cout);
+   *      }
+   * @endrst
+   *
+   * @return The number of elements drained
+   */
+  template<typename GeneratorType,
+           typename StreamType,
+           typename = std::enable_if_t<std::is_base_of<std::ostream, StreamType>::value, void>>
+  std::size_t drain(GeneratorType && generator, StreamType & stream, std::string_view separator = "\n")
+    {
+    constexpr auto flush_threshold = std::size_t{16384};
+
+    auto buffer = std::string{};
+    buffer.reserve(flush_threshold);
+
+    auto count = std::size_t{};
+    while(generator.next())
+      {
+      string::format_to(buffer, "{0}", generator.value());
+      buffer.append(separator);
+      ++count;
+
+      if(buffer.size() >= flush_threshold)
+        {
+        stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+        }
+      }
+
+    stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return count;
+    }
+
+  }
+
+#endif
@@ -0,0 +1,431 @@
+#ifndef SOPHIA_INSTRUMENT__COUNTERS
+#define SOPHIA_INSTRUMENT__COUNTERS
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(SOPHIA_ENABLE_INSTRUMENTATION)
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace sophia::instrument
+  {
+
+  /**
+   * @ingroup sophia_instrument
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Whether instrumentation was enabled at compile-time by defining @p SOPHIA_ENABLE_INSTRUMENTATION
+   */
+#if defined(SOPHIA_ENABLE_INSTRUMENTATION)
+  constexpr bool enabled{true};
+#else
+  constexpr bool enabled{false};
+#endif
+
+  /**
+   * @ingroup sophia_instrument
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The instrumented code paths
+   *
+   * @note The counters of @p printf include the formatting of its output. A call of #sophia::io::printf is not counted as a
+   * call of @p format.
+   */
+  enum struct probe : std::size_t
+    {
+    format,
+    printf,
+    record,
+    };
+
+  /**
+   * @ingroup sophia_instrument
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The number of instrumented code paths
+   */
+  constexpr std::size_t probe_count{3};
+
+  /**
+   * @ingroup sophia_instrument
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The number of buckets of a latency histogram
+   *
+   * Bucket @p n counts the calls that took at least 2^(n-1) and less than 2^n ticks. Bucket 0 counts the calls that took
+   * less than one tick.
+   */
+  constexpr std::size_t histogram_buckets{48};
+
+  /**
+   * @ingroup sophia_instrument
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The unit of the latency histograms
+   *
+   * On x86 processors, latencies are measured in time-stamp counter cycles. On other platforms, they are measured in
+   * nanoseconds.
+   */
+#if defined(__x86_64__) || defined(__i386__)
+  constexpr char const * tick_unit{"cycles"};
+#else
+  constexpr char const * tick_unit{"ns"};
+#endif
+
+  /**
+   * @ingroup sophia_instrument
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The aggregated counters of a single probe
+   */
+  struct statistics
+    {
+    /**
+     * @brief The number of calls
+     */
+    std::uint64_t calls{};
+
+    /**
+     * @brief The number of bytes produced
+     */
+    std::uint64_t bytes{};
+
+    /**
+     * @brief The number of times the output buffer had to be (re)allocated
+     */
+    std::uint64_t allocations{};
+
+    /**
+     * @brief The latency histogram, see #sophia::instrument::histogram_buckets
+     */
+    std::array<std::uint64_t, histogram_buckets> histogram{};
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Get an upper bound of the given percentile of the latency in ticks
+     *
+     * @param fraction The percentile as a fraction between 0 and 1
+     */
+    std::uint64_t percentile(double fraction) const
+      {
+      auto const threshold = static_cast<std::uint64_t>(fraction * calls);
+      auto seen = std::uint64_t{};
+      for(auto bucket = 0ull; bucket < histogram_buckets; ++bucket)
+        {
+        seen += histogram[bucket];
+        if(seen && seen >= threshold)
+          {
+          return std::uint64_t{1} << bucket;
+          }
+        }
+      return 0;
+      }
+    };
+
+  /**
+   * @ingroup sophia_instrument
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The aggregated counters of all probes at a point in time
+   */
+  struct snapshot
+    {
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Access the statistics of the given probe
+     */
+    statistics const & operator[](probe which) const
+      {
+      return probes[static_cast<std::size_t>(which)];
+      }
+
+    std::array<statistics, probe_count> probes{};
+    };
+
+#if defined(SOPHIA_ENABLE_INSTRUMENTATION)
+
+  namespace internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief The counters of a single probe on a single thread
+     *
+     * Each instance is only ever written by its owning thread. The counters are atomic so that they can be read
+     * concurrently during aggregation, but they are updated with plain relaxed loads and stores instead of read-modify-write
+     * operations, which makes updating them as cheap as updating ordinary variables.
+     */
+    struct probe_counters
+      {
+      std::atomic<std::uint64_t> calls{};
+      std::atomic<std::uint64_t> bytes{};
+      std::atomic<std::uint64_t> allocations{};
+      std::array<std::atomic<std::uint64_t>, histogram_buckets> histogram{};
+      };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Increment a counter owned by the current thread
+     */
+    inline void bump(std::atomic<std::uint64_t> & counter, std::uint64_t amount)
+      {
+      counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Add the values of a set of counters to the given statistics
+     */
+    inline void accumulate(statistics & target, probe_counters const & source)
+      {
+      target.calls += source.calls.load(std::memory_order_relaxed);
+      target.bytes += source.bytes.load(std::memory_order_relaxed);
+      target.allocations += source.allocations.load(std::memory_order_relaxed);
+      for(auto bucket = 0ull; bucket < histogram_buckets; ++bucket)
+        {
+        target.histogram[bucket] += source.histogram[bucket].load(std::memory_order_relaxed);
+        }
+      }
+
+    struct thread_counters;
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief The registry of the counters of all live threads and the totals of all exited threads
+     */
+    struct registry
+      {
+      std::mutex mutex{};
+      std::vector<thread_counters *> live{};
+      snapshot retired{};
+      };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Access the global registry
+     *
+     * The registry is intentionally never destroyed, so that threads exiting during static destruction can still retire
+     * their counters.
+     */
+    inline registry & global_registry()
+      {
+      static auto instance = new registry{};
+      return *instance;
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief The counters of all probes on a single thread
+     *
+     * The counters register themselves with the global registry on construction, and fold their values into the retired
+     * totals on destruction.
+     */
+    struct thread_counters
+      {
+      thread_counters()
+        {
+        auto & registry = global_registry();
+        auto lock = std::lock_guard<std::mutex>{registry.mutex};
+        registry.live.push_back(this);
+        }
+
+      ~thread_counters()
+        {
+        auto & registry = global_registry();
+        auto lock = std::lock_guard<std::mutex>{registry.mutex};
+        for(auto index = 0ull; index < probe_count; ++index)
+          {
+          accumulate(registry.retired.probes[index], probes[index]);
+          }
+        registry.live.erase(std::find(registry.live.begin(), registry.live.end(), this));
+        }
+
+      thread_counters(thread_counters const &) = delete;
+      thread_counters & operator=(thread_counters const &) = delete;
+
+      std::array<probe_counters, probe_count> probes{};
+      };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Access the counters of the given probe on the current thread
+     */
+    inline probe_counters & local(probe which)
+      {
+      thread_local thread_counters counters{};
+      return counters.probes[static_cast<std::size_t>(which)];
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Read the current tick count
+     */
+    inline std::uint64_t ticks()
+      {
+#if defined(__x86_64__) || defined(__i386__)
+      return __rdtsc();
+#else
+      auto const now = std::chrono::steady_clock::now().time_since_epoch();
+      return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+#endif
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Determine the histogram bucket of the given latency
+     */
+    inline std::size_t bucket(std::uint64_t ticks)
+      {
+      auto const width = ticks ? 64 - static_cast<std::size_t>(__builtin_clzll(ticks)) : 0;
+      return std::min(width, histogram_buckets - 1);
+      }
+
+    }
+
+  /**
+   * @ingroup sophia_instrument
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Aggregate the counters of all threads
+   *
+   * The counters of threads that have exited are included. Counters are never reset; to measure a section of a program,
+   * take a snapshot before and after it and compare the two.
+   */
+  inline snapshot collect()
+    {
+    auto & registry = internal::global_registry();
+    auto lock = std::lock_guard<std::mutex>{registry.mutex};
+    auto result = registry.retired;
+    for(auto counters : registry.live)
+      {
+      for(auto index = 0ull; index < probe_count; ++index)
+        {
+        internal::accumulate(result.probes[index], counters->probes[index]);
+        }
+      }
+    return result;
+    }
+
+  /**
+   * @ingroup sophia_instrument
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Record a single call of an instrumented code path
+   *
+   * The call is counted and its latency measured from construction to destruction of the scope object.
+   */
+  struct scope
+    {
+    explicit scope(probe which)
+      : m_counters{internal::local(which)},
+        m_start{internal::ticks()}
+      {
+
+      }
+
+    ~scope()
+      {
+      auto const elapsed = internal::ticks() - m_start;
+      internal::bump(m_counters.calls, 1);
+      internal::bump(m_counters.histogram[internal::bucket(elapsed)], 1);
+      }
+
+    scope(scope const &) = delete;
+    scope & operator=(scope const &) = delete;
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Record the given number of bytes as being produced by the call
+     */
+    void produced(std::size_t bytes)
+      {
+      internal::bump(m_counters.bytes, bytes);
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Record the given number of heap allocations as being made by the call
+     */
+    void allocated(std::size_t allocations)
+      {
+      internal::bump(m_counters.allocations, allocations);
+      }
+
+    private:
+      internal::probe_counters & m_counters;
+      std::uint64_t const m_start;
+    };
+
+#else
+
+  inline snapshot collect()
+    {
+    return {};
+    }
+
+  struct scope
+    {
+    explicit constexpr scope(probe) { }
+    constexpr void produced(std::size_t) { }
+    constexpr void allocated(std::size_t) { }
+    };
+
+#endif
+
+  }
+
+#endif
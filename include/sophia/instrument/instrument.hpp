@@ -0,0 +1,28 @@
+#ifndef SOPHIA_INSTRUMENT__INSTRUMENT
+#define SOPHIA_INSTRUMENT__INSTRUMENT
+
+/**
+ * @namespace sophia::instrument
+ * @author Felix Morgner
+ * @since 0.3
+ *
+ * @brief The Sophia Template Library Instrumentation module
+ */
+
+/**
+ * @defgroup sophia_instrument Instrumentation
+ * @author Felix Morgner
+ * @since 0.3
+ *
+ * @brief The sophia Instrumentation module
+ *
+ * This module provides per-thread counters for the hot paths of the library, like formatting and printing. The counters
+ * track the number of calls, the number of bytes produced, the number of output buffer allocations, and a latency histogram.
+ * They are aggregated on demand via #sophia::instrument::collect. Instrumentation is opt-in and must be enabled by defining
+ * @p SOPHIA_ENABLE_INSTRUMENTATION, consistently across all translation units of a program. When it is not enabled, all
+ * hooks compile to nothing.
+ */
+
+#include "sophia/instrument/counters.hpp"
+
+#endif
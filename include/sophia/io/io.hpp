@@ -14,6 +14,7 @@
  */
 
 #include "sophia/io/printf.hpp"
+#include "sophia/io/record.hpp"
 #include "sophia/io/write.hpp"
 
 #endif
@@ -1,13 +1,44 @@
 #ifndef SOPHIA_IO__PRINTF
 #define SOPHIA_IO__PRINTF
 
+#include "sophia/instrument/counters.hpp"
 #include "sophia/string/format.hpp"
 
 #include <iostream>
+#include <string>
+#include <string_view>
 
 namespace sophia::io
   {
 
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Print the given type-erased arguments according to a format string
+   *
+   * This function is the non-template core of #printf. All printf calls share this single implementation, regardless of
+   * the types of their arguments. The output is formatted into a buffer, which is then written to the stream at once.
+   *
+   * @param stream The stream to print to.
+   * @param format A python like format-string using {#} as placeholders, where # is the index of the parameter to print.
+   * @param arguments The type-erased values to substitute for the placeholders.
+   */
+  inline void vprintf(std::ostream & stream, std::string_view format, string::format_arguments arguments)
+    {
+    auto probe = instrument::scope{instrument::probe::printf};
+    auto text = std::string{};
+    auto const allocations = string::internal::vformat_to(text, format, arguments);
+    stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+
+    if constexpr(instrument::enabled)
+      {
+      probe.produced(text.size());
+      probe.allocated(allocations);
+      }
+    }
+
   /**
    * @ingroup sophia_io
    *
@@ -39,9 +70,9 @@ namespace sophia::io
   template<typename StreamType,
            typename = std::enable_if_t<std::is_base_of<std::ostream, StreamType>::value, void>,
            typename ...ArgumentTypes >
-  void printf(StreamType & stream, std::string const & format, ArgumentTypes && ...values)
+  void printf(StreamType & stream, std::string_view format, ArgumentTypes const & ...values)
     {
-    stream << sophia::string::format(format, std::forward<ArgumentTypes>(values)...);
+    vprintf(stream, format, string::make_format_arguments(values...));
     }
 
   /**
@@ -74,9 +105,9 @@ namespace sophia::io
    * @since 0.1
    */
   template<typename ...ArgumentTypes>
-  void printf(std::string const & format, ArgumentTypes && ...values)
+  void printf(std::string_view format, ArgumentTypes const & ...values)
     {
-    printf(std::cout, format, std::forward<ArgumentTypes>(values)...);
+    vprintf(std::cout, format, string::make_format_arguments(values...));
     }
 
   }
@@ -0,0 +1,604 @@
+#ifndef SOPHIA_IO__RECORD
+#define SOPHIA_IO__RECORD
+
+#include "sophia/instrument/counters.hpp"
+#include "sophia/string/format.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace sophia::io
+  {
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The encodings supported by #sophia::io::write_record
+   */
+  enum struct record_format
+    {
+    /**
+     * @brief One JSON object per record, e.g. @p {"level":"info","status":200}
+     */
+    json,
+
+    /**
+     * @brief One line of space separated @p key=value pairs per record, e.g. @p level=info @p status=200
+     *
+     * Keys and values that are empty, or contain spaces, equal signs, quotes, backslashes or control characters, are quoted
+     * and escaped like JSON strings, so that every record can be split into its pairs unambiguously.
+     */
+    logfmt,
+    };
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A key/value pair of a structured record
+   *
+   * A field refers to its value, which must therefore outlive the field. Fields are intended to be created directly in the
+   * argument list of #sophia::io::write_record.
+   */
+  template<typename ValueType>
+  struct field
+    {
+    field(std::string_view key, ValueType const & value)
+      : key{key},
+        value{value}
+      {
+
+      }
+
+    std::string_view key;
+    ValueType const & value;
+    };
+
+  template<typename ValueType>
+  field(char const *, ValueType const &) -> field<ValueType>;
+
+  template<typename ValueType>
+  field(std::string_view, ValueType const &) -> field<ValueType>;
+
+  namespace internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief The escape sequences of the ASCII control characters
+     */
+    constexpr char const * control_escapes[32]{
+      "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005", "\\u0006", "\\u0007",
+      "\\b",     "\\t",     "\\n",     "\\u000b", "\\f",     "\\r",     "\\u000e", "\\u000f",
+      "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
+      "\\u0018", "\\u0019", "\\u001a", "\\u001b", "\\u001c", "\\u001d", "\\u001e", "\\u001f",
+    };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Append the escape sequence of a single character that requires escaping
+     */
+    inline void escape_character(std::string & output, char character)
+      {
+      auto const code = static_cast<unsigned char>(character);
+      if(code < 0x20)
+        {
+        output.append(control_escapes[code]);
+        }
+      else
+        {
+        output += '\\';
+        output += character;
+        }
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Check if a character must be escaped inside a JSON string
+     */
+    inline bool needs_escape(char character)
+      {
+      return static_cast<unsigned char>(character) < 0x20 || character == '"' || character == '\\';
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Append the given characters, escaping them for use inside a JSON string, one character at a time
+     */
+    inline void escape_scalar(std::string & output, std::string_view text)
+      {
+      auto run = text.data();
+      auto const last = text.data() + text.size();
+      for(auto current = run; current != last; ++current)
+        {
+        if(needs_escape(*current))
+          {
+          output.append(run, static_cast<std::size_t>(current - run));
+          escape_character(output, *current);
+          run = current + 1;
+          }
+        }
+      output.append(run, static_cast<std::size_t>(last - run));
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Append the given characters, escaping them for use inside a JSON string
+     *
+     * Where SSE2 is available, the characters are scanned 16 at a time for quotes, backslashes and control characters.
+     * Runs of characters that do not need escaping are copied in bulk.
+     */
+    inline void escape(std::string & output, std::string_view text)
+      {
+      string::internal::reserve(output, output.size() + text.size());
+
+#if defined(__SSE2__)
+      auto run = text.data();
+      auto current = run;
+      auto const last = text.data() + text.size();
+
+      auto const quote = _mm_set1_epi8('"');
+      auto const backslash = _mm_set1_epi8('\\');
+      auto const control = _mm_set1_epi8(0x1f);
+
+      while(last - current >= 16)
+        {
+        auto const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(current));
+        auto const special = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+          _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk)
+        );
+
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+        if(!mask)
+          {
+          current += 16;
+          continue;
+          }
+
+        while(mask)
+          {
+          auto const position = current + __builtin_ctz(mask);
+          output.append(run, static_cast<std::size_t>(position - run));
+          escape_character(output, *position);
+          run = position + 1;
+          mask &= mask - 1;
+          }
+
+        current += 16;
+        }
+
+      output.append(run, static_cast<std::size_t>(current - run));
+      escape_scalar(output, {current, static_cast<std::size_t>(last - current)});
+#else
+      escape_scalar(output, text);
+#endif
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Check if a logfmt key or value needs to be quoted
+     */
+    inline bool needs_quotes(std::string_view text)
+      {
+      if(text.empty())
+        {
+        return true;
+        }
+
+      for(auto character : text)
+        {
+        if(character == ' ' || character == '=' || needs_escape(character))
+          {
+          return true;
+          }
+        }
+
+      return false;
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief A type-erased field of a structured record
+     */
+    struct record_field
+      {
+      enum struct kind
+        {
+        boolean,
+        signed_integer,
+        unsigned_integer,
+        single_precision,
+        double_precision,
+        text,
+        formatted,
+        };
+
+      std::string_view key;
+      kind type;
+      union
+        {
+        bool boolean;
+        std::int64_t signed_integer;
+        std::uint64_t unsigned_integer;
+        float single_precision;
+        double double_precision;
+        } number;
+      std::string_view text;
+      string::format_argument argument;
+      };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Create a type-erased record field from a typed one
+     *
+     * Numbers and strings are captured by value, so that they can be written without any intermediate allocation. All
+     * other values are captured as #sophia::string::format_argument and are formatted like #sophia::string::format would.
+     */
+    template<typename ValueType>
+    record_field erase_field(field<ValueType> const & field)
+      {
+      using kind = record_field::kind;
+      auto erased = record_field{field.key, kind::formatted, {}, {}, {}};
+
+      if constexpr(std::is_same<ValueType, bool>::value)
+        {
+        erased.type = kind::boolean;
+        erased.number.boolean = field.value;
+        }
+      else if constexpr(string::internal::is_character<ValueType>::value)
+        {
+        erased.type = kind::text;
+        erased.text = std::string_view{reinterpret_cast<char const *>(&field.value), 1};
+        }
+      else if constexpr(std::is_integral<ValueType>::value && std::is_signed<ValueType>::value)
+        {
+        erased.type = kind::signed_integer;
+        erased.number.signed_integer = field.value;
+        }
+      else if constexpr(std::is_integral<ValueType>::value)
+        {
+        erased.type = kind::unsigned_integer;
+        erased.number.unsigned_integer = field.value;
+        }
+      else if constexpr(std::is_same<ValueType, float>::value)
+        {
+        erased.type = kind::single_precision;
+        erased.number.single_precision = field.value;
+        }
+      else if constexpr(std::is_floating_point<ValueType>::value)
+        {
+        erased.type = kind::double_precision;
+        erased.number.double_precision = static_cast<double>(field.value);
+        }
+      else if constexpr(std::is_array<ValueType>::value && std::is_same<std::remove_extent_t<ValueType>, char>::value)
+        {
+        erased.type = kind::text;
+        erased.text = std::string_view{field.value};
+        }
+      else if constexpr(std::is_same<ValueType, char const *>::value || std::is_same<ValueType, char *>::value)
+        {
+        erased.type = kind::text;
+        erased.text = field.value ? std::string_view{field.value} : std::string_view{};
+        }
+      else if constexpr(std::is_convertible<ValueType const &, std::string_view>::value)
+        {
+        erased.type = kind::text;
+        erased.text = std::string_view{field.value};
+        }
+      else
+        {
+        erased.argument = string::internal::erase_argument(field.value);
+        }
+
+      return erased;
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Append a number via std::to_chars
+     */
+    template<typename NumberType>
+    void append_number(std::string & output, NumberType number)
+      {
+      char buffer[32];
+      auto const last = std::to_chars(buffer, buffer + sizeof(buffer), number).ptr;
+      output.append(buffer, static_cast<std::size_t>(last - buffer));
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Append a string value, or a logfmt key, in the given encoding
+     */
+    inline void append_text(std::string & output, record_format format, std::string_view text)
+      {
+      if(format == record_format::logfmt && !needs_quotes(text))
+        {
+        output.append(text);
+        return;
+        }
+
+      output += '"';
+      escape(output, text);
+      output += '"';
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Append the value of a type-erased record field in the given encoding
+     */
+    inline void append_value(std::string & output, record_format format, record_field const & field, std::string & scratch)
+      {
+      using kind = record_field::kind;
+
+      switch(field.type)
+        {
+        case kind::boolean:
+          output.append(field.number.boolean ? "true" : "false");
+          break;
+        case kind::signed_integer:
+          append_number(output, field.number.signed_integer);
+          break;
+        case kind::unsigned_integer:
+          append_number(output, field.number.unsigned_integer);
+          break;
+        case kind::single_precision:
+          if(format == record_format::json && !std::isfinite(field.number.single_precision))
+            {
+            output.append("null");
+            break;
+            }
+          append_number(output, field.number.single_precision);
+          break;
+        case kind::double_precision:
+          if(format == record_format::json && !std::isfinite(field.number.double_precision))
+            {
+            output.append("null");
+            break;
+            }
+          append_number(output, field.number.double_precision);
+          break;
+        case kind::text:
+          append_text(output, format, field.text);
+          break;
+        case kind::formatted:
+          {
+          scratch.clear();
+          auto target = string::internal::format_target{scratch};
+          field.argument.format(target, field.argument.value);
+          append_text(output, format, scratch);
+          }
+          break;
+        }
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Access a per-thread scratch buffer for formatting values that are neither numbers nor strings
+     */
+    inline std::string & record_scratch()
+      {
+      thread_local auto scratch = std::string{};
+      return scratch;
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Access a per-thread buffer for encoding records written to streams
+     */
+    inline std::string & record_buffer()
+      {
+      thread_local auto buffer = std::string{};
+      return buffer;
+      }
+
+    }
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Append a structured record, given as type-erased fields, to a buffer
+   *
+   * This function is the non-template core of #sophia::io::write_record.
+   */
+  inline void vwrite_record(std::string & output,
+                            record_format format,
+                            internal::record_field const * fields,
+                            std::size_t count)
+    {
+    auto probe = instrument::scope{instrument::probe::record};
+    auto const initial_size = output.size();
+    auto const initial_capacity = output.capacity();
+    auto & scratch = internal::record_scratch();
+
+    if(format == record_format::json)
+      {
+      output += '{';
+      }
+
+    for(auto index = 0ull; index < count; ++index)
+      {
+      auto const & field = fields[index];
+      if(format == record_format::json)
+        {
+        if(index)
+          {
+          output += ',';
+          }
+        output += '"';
+        internal::escape(output, field.key);
+        output.append("\":");
+        }
+      else
+        {
+        if(index)
+          {
+          output += ' ';
+          }
+        internal::append_text(output, format, field.key);
+        output += '=';
+        }
+
+      internal::append_value(output, format, field, scratch);
+      }
+
+    if(format == record_format::json)
+      {
+      output += '}';
+      }
+    output += '\n';
+
+    if constexpr(instrument::enabled)
+      {
+      probe.produced(output.size() - initial_size);
+      probe.allocated(output.capacity() != initial_capacity);
+      }
+    }
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Write a structured record, given as type-erased fields, to a stream
+   *
+   * The record is encoded in a per-thread buffer, so that no allocation takes place once the buffer has grown to the size of
+   * the largest record.
+   */
+  inline void vwrite_record(std::ostream & stream,
+                            record_format format,
+                            internal::record_field const * fields,
+                            std::size_t count)
+    {
+    auto & buffer = internal::record_buffer();
+    buffer.clear();
+    vwrite_record(buffer, format, fields, count);
+    stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Append a structured record to a buffer
+   *
+   * This function writes the given fields as a single line in the requested encoding. Booleans, integers and floating
+   * point numbers are written as bare values without any intermediate allocation. Strings are quoted and escaped as
+   * required by the encoding, using vectorized scanning for long strings. Values of other types are formatted exactly like
+   * #sophia::string::format formats them (i.e. via #sophia::formatter, @p operator<<, or as type and address) and are then
+   * written as strings. In JSON, non-finite floating point numbers are written as @p null.
+   *
+   * @par Example:
+   * @rst
+   * .. code-block:: c++
+   *    :linenos:
+   *
+   *    #include <sophia/io/record.hpp>
+   *
+   *    int main()
+   *      {
+   *      using namespace sophia::io;
+   *
+   *      auto buffer = std::string{};
+   *      write_record(buffer, record_format::json, field{"level", "info"}, field{"status", 200});
+   *      // buffer == "{\"level\":\"info\",\"status\":200}\n"
+   *      }
+   * @endrst
+   *
+   * @param output The buffer to append to.
+   * @param format The encoding of the record.
+   * @param fields The fields of the record.
+   * @author Felix Morgner
+   * @since 0.3
+   */
+  template<typename ...ValueTypes>
+  void write_record(std::string & output, record_format format, field<ValueTypes> const & ...fields)
+    {
+    internal::record_field const erased[sizeof...(fields) + 1]{internal::erase_field(fields)...};
+    vwrite_record(output, format, erased, sizeof...(fields));
+    }
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Write a structured record to a stream
+   *
+   * This function behaves like #write_record, but writes the record to the given stream. The record is encoded in a
+   * per-thread buffer, so that no allocation takes place once the buffer has grown to the size of the largest record.
+   *
+   * @param stream The stream to write to. Must be descendent from std::ostream.
+   * @param format The encoding of the record.
+   * @param fields The fields of the record.
+   * @author Felix Morgner
+   * @since 0.3
+   */
+  template<typename StreamType,
+           typename = std::enable_if_t<std::is_base_of<std::ostream, StreamType>::value, void>,
+           typename ...ValueTypes>
+  void write_record(StreamType & stream, record_format format, field<ValueTypes> const & ...fields)
+    {
+    internal::record_field const erased[sizeof...(fields) + 1]{internal::erase_field(fields)...};
+    vwrite_record(stream, format, erased, sizeof...(fields));
+    }
+
+  }
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef SOPHIA_META__TRAITS
 #define SOPHIA_META__TRAITS
 
+#include "sophia/concept/format.hpp"
 #include "sophia/concept/io.hpp"
 
 namespace sophia::meta
@@ -24,6 +25,24 @@ namespace sophia::meta
   template<typename Type>
   struct is_outputable<Type, concept::outputable<Type>> : std::true_type {};
 
+  template<typename Type, typename = void>
+  struct is_formatable : std::false_type {};
+
+  /**
+   * @ingroup sophia_meta
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Check if a type satifies the concept "formatable"
+   *
+   * This meta-programming class makes it possible to check if a type satifies the concept "formatable". For types that
+   * satisfy this concept, #sophia::formatter must be specialized.
+   *
+   * @sa sophia::concept::formatable
+   */
+  template<typename Type>
+  struct is_formatable<Type, concept::formatable<Type>> : std::true_type {};
+
   }
 
 #endif
@@ -3,11 +3,22 @@
 
 #include "sophia/concept/io.hpp"
 #include "sophia/concept/type_descriptor.hpp"
+#include "sophia/instrument/counters.hpp"
+#include "sophia/meta/traits.hpp"
+#include "sophia/string/formatter.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstring>
+#include <limits>
 #include <memory>
-#include <sstream>
+#include <optional>
+#include <ostream>
+#include <streambuf>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <typeinfo>
 
 #include <cxxabi.h>
@@ -45,63 +56,134 @@ namespace sophia::string
       return demangled.get();
       }
 
+
     /**
      * @internal
      * @author Felix Morgner
-     * @since 0.1
-     *
-     * @brief A type-unaware wrapper for formatable objects
+     * @since 0.3
      *
-     * This abstract base defines a type-independent interface for object that can be formatted. This is required since type
-     * information matters when formatting, but at the same time having a type-aware base would prohibit the use of standard
-     * containers.
+     * @brief A stream buffer appending all characters written to it to a std::string
      */
-    struct formatable
+    struct string_appender : std::streambuf
       {
       /**
        * @internal
        * @author Felix Morgner
-       * @since 0.1
+       * @since 0.3
        *
-       * @brief Print a description of the wrapped value
+       * @brief Construct a new string_appender appending to the given string
        */
-      virtual void format(std::ostream &) = 0;
+      explicit string_appender(std::string & target)
+        : m_target{target}
+        {
+
+        }
+
+      protected:
+        int_type overflow(int_type character) override
+          {
+          if(!traits_type::eq_int_type(character, traits_type::eof()))
+            {
+            m_target.push_back(traits_type::to_char_type(character));
+            }
+
+          return traits_type::not_eof(character);
+          }
+
+        std::streamsize xsputn(char_type const * characters, std::streamsize count) override
+          {
+          m_target.append(characters, static_cast<std::size_t>(count));
+          return count;
+          }
+
+      private:
+        std::string & m_target;
       };
 
     /**
      * @internal
      * @author Felix Morgner
-     * @since 0.1
+     * @since 0.3
      *
-     * @brief A fully type-aware wrapper for non-formatable objects
+     * @brief The destination of a formatting operation
      *
-     * This concrete implementation of #sophia::io::internal::formatable provides a generic wrapper for objects of types that
-     * do not support the use of operator "<<" in order to write them to a stream. Instead it formats the type information and
-     * the address of the object.
+     * This class provides access to the string being formatted into. Arguments that need to be written via
+     * @p operator<<(std::ostream &, Type const &) can obtain a stream appending to the same string. The stream is only
+     * constructed when it is first requested.
      */
-    template<typename ValueType, typename = void>
-    struct typed_formatable: formatable
+    struct format_target
       {
       /**
        * @internal
        * @author Felix Morgner
-       * @since 0.1
+       * @since 0.3
        *
-       * @brief Construct a new typed_formatable wrapping the given value
+       * @brief Construct a new format_target appending to the given string
        */
-      typed_formatable(ValueType const & value)
-        : m_contained{value}
+      explicit format_target(std::string & output)
+        : m_output{output},
+          m_appender{output}
         {
 
         }
 
-      void format(std::ostream & stream) override
+      /**
+       * @internal
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Access the string being formatted into
+       */
+      std::string & output()
+        {
+        return m_output;
+        }
+
+      /**
+       * @internal
+       * @author Felix Morgner
+       * @since 0.3
+       *
+       * @brief Access a stream appending to the string being formatted into
+       */
+      std::ostream & stream()
         {
-        stream << '<' << demangle(typeid(ValueType)) << '@' << &m_contained << '>';
+        if(!m_stream)
+          {
+          m_stream.emplace(&m_appender);
+          }
+
+        return *m_stream;
         }
 
       private:
-        ValueType const & m_contained;
+        std::string & m_output;
+        string_appender m_appender;
+        std::optional<std::ostream> m_stream{};
+      };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.1
+     *
+     * @brief A fully type-aware formatting function for non-formatable objects
+     *
+     * This generic implementation is used for objects of types that do not support the use of operator "<<" in order to
+     * write them to a stream. Instead it formats the type information and the address of the object.
+     */
+    template<typename ValueType, typename = void>
+    struct typed_formatable
+      {
+      static void write(std::ostream & stream, void const * value)
+        {
+        stream << '<' << demangle(typeid(ValueType)) << '@' << value << '>';
+        }
+
+      static void format(format_target & target, void const * value)
+        {
+        write(target.stream(), value);
+        }
       };
 
     /**
@@ -109,36 +191,488 @@ namespace sophia::string
      * @author Felix Morgner
      * @since 0.1
      *
-     * @brief A fully type-aware wrapper for formatable objects
+     * @brief A fully type-aware formatting function for formatable objects
      *
-     * This concrete implementation of #sophia::io::internal::formatable provides a generic wrapper for objects of types that
-     * support the use of operator "<<" in order to write them to a stream.
+     * This specialization is used for objects of types that support the use of operator "<<" in order to write them to a
+     * stream.
      */
     template<typename ValueType>
-    struct typed_formatable<ValueType, concept::outputable<ValueType>> : formatable
+    struct typed_formatable<ValueType, concept::outputable<ValueType>>
       {
-      /**
-       * @internal
-       * @author Felix Morgner
-       * @since 0.1
-       *
-       * @brief Construct a new typed_formatable wrapping the given value
-       */
-      typed_formatable(ValueType const & value)
-        : m_contained{value}
+      static void write(std::ostream & stream, void const * value)
         {
+        stream << *static_cast<ValueType const *>(value);
+        }
 
+      static void format(format_target & target, void const * value)
+        {
+        write(target.stream(), value);
         }
+      };
 
-      void format(std::ostream & stream) override
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief A fully type-aware formatting function for objects of types with a sophia::formatter specialization
+     *
+     * The formatter writes directly into the string being formatted into, bypassing the stream entirely. Small results are
+     * written to a buffer on the stack first, so the string does not need to be resized twice.
+     */
+    template<typename ValueType>
+    struct formatter_formatable
+      {
+      static std::size_t size(void const * value)
         {
-        stream << m_contained;
+        return formatter<ValueType>{}.max_size(*static_cast<ValueType const *>(value));
         }
 
-      private:
-        ValueType const & m_contained;
+      static void format(format_target & target, void const * value)
+        {
+        auto const & object = *static_cast<ValueType const *>(value);
+        auto formatter = sophia::formatter<ValueType>{};
+        auto & output = target.output();
+        auto const size = static_cast<std::size_t>(formatter.max_size(object));
+
+        if(size <= 64)
+          {
+          char buffer[64];
+          auto const last = formatter.format(object, buffer);
+          output.append(buffer, static_cast<std::size_t>(last - buffer));
+          }
+        else
+          {
+          auto const offset = output.size();
+          output.resize(offset + size);
+          auto const last = formatter.format(object, output.data() + offset);
+          output.resize(static_cast<std::size_t>(last - output.data()));
+          }
+        }
       };
 
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Format a character array
+     *
+     * Character arrays, most notably string literals, share this function regardless of their extent.
+     */
+    inline void format_characters(format_target & target, void const * value)
+      {
+      target.output().append(static_cast<char const *>(value));
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Determine the size of a character array
+     */
+    inline std::size_t measure_characters(void const * value)
+      {
+      return std::strlen(static_cast<char const *>(value));
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Ensure that the given string can hold at least @p required characters without reallocating
+     *
+     * Some implementations of @p std::string::reserve allocate exactly the requested capacity. Reserving a little more space
+     * before every append would thus reallocate on almost every call. Instead, the capacity is only increased if it is too
+     * small, and then at least doubled.
+     *
+     * @return Whether the string had to be reallocated
+     */
+    inline bool reserve(std::string & output, std::size_t required)
+      {
+      if(required <= output.capacity())
+        {
+        return false;
+        }
+
+      output.reserve(std::max(required, 2 * output.capacity()));
+      return true;
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Parse the index of a placeholder
+     *
+     * The index is parsed like @p std::stoull parses a number: leading whitespace is skipped, an optional sign is accepted,
+     * and any characters following the digits are ignored. Like @p std::stoull, a negative number wraps around.
+     *
+     * @return The number denoted by the placeholder, or nothing if the placeholder does not start with a representable number
+     */
+    constexpr std::optional<unsigned long long> placeholder_index(std::string_view placeholder)
+      {
+      auto position = placeholder.find_first_not_of(" \t\n\v\f\r");
+      if(position == std::string_view::npos)
+        {
+        return std::nullopt;
+        }
+
+      auto const negative = placeholder[position] == '-';
+      if(negative || placeholder[position] == '+')
+        {
+        ++position;
+        }
+
+      if(position == placeholder.size() || placeholder[position] < '0' || placeholder[position] > '9')
+        {
+        return std::nullopt;
+        }
+
+      auto index = 0ull;
+      for(; position < placeholder.size() && placeholder[position] >= '0' && placeholder[position] <= '9'; ++position)
+        {
+        auto const digit = static_cast<unsigned long long>(placeholder[position] - '0');
+        if(index > (std::numeric_limits<unsigned long long>::max() - digit) / 10)
+          {
+          return std::nullopt;
+          }
+        index = index * 10 + digit;
+        }
+
+      return negative ? 0ull - index : index;
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Split a format string into literal text and argument references
+     *
+     * This function implements the placeholder syntax shared by #sophia::string::vformat_to and
+     * #sophia::string::static_format, and can be used in constant expressions. Placeholders that do not denote a number are
+     * passed on as literal text, including their braces. Placeholders denoting a number not below @p limit are passed on as
+     * that number in braces, so that e.g. "{007}" becomes "{7}".
+     *
+     * @param format The format string to parse
+     * @param limit The number of arguments
+     * @param text A callable object accepting a @p std::string_view of literal text
+     * @param argument A callable object accepting the index of a referenced argument and its placeholder, including braces
+     */
+    template<typename TextHandlerType, typename ArgumentHandlerType>
+    constexpr void parse_format(std::string_view format,
+                                std::size_t limit,
+                                TextHandlerType && text,
+                                ArgumentHandlerType && argument)
+      {
+      auto lastpos = std::size_t{};
+      auto opening = std::size_t{};
+
+      while((opening = format.find('{', lastpos)) != std::string_view::npos)
+        {
+        auto const closing = format.find('}', opening);
+        if(closing == std::string_view::npos)
+          {
+          break;
+          }
+
+        text(format.substr(lastpos, opening - lastpos));
+        lastpos = closing + 1;
+
+        auto const placeholder = format.substr(opening, closing - opening + 1);
+        auto const index = placeholder_index(placeholder.substr(1, placeholder.size() - 2));
+        if(!index)
+          {
+          text(placeholder);
+          }
+        else if(*index < limit)
+          {
+          argument(static_cast<std::size_t>(*index), placeholder);
+          }
+        else
+          {
+          char digits[20]{};
+          auto count = sizeof(digits);
+          auto value = *index;
+          do
+            {
+            digits[--count] = static_cast<char>('0' + value % 10);
+            value /= 10;
+            }
+          while(value);
+
+          text("{");
+          text(std::string_view{digits + count, sizeof(digits) - count});
+          text("}");
+          }
+        }
+
+      text(format.substr(lastpos));
+      }
+
+    }
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A type-erased reference to a single format argument
+   *
+   * Objects of this type are created by #sophia::string::make_format_arguments. They refer to the original argument, which
+   * must therefore outlive the formatting operation. If the size function is not null, it returns an upper bound of the
+   * number of characters the argument will be formatted to.
+   */
+  struct format_argument
+    {
+    void const * value;
+    void (* format)(internal::format_target &, void const *);
+    std::size_t (* size)(void const *);
+    };
+
+  namespace internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Create a type-erased format argument referring to the given value
+     */
+    template<typename ValueType>
+    format_argument erase_argument(ValueType const & value)
+      {
+      if constexpr(std::is_array<ValueType>::value && std::is_same<std::remove_extent_t<ValueType>, char>::value)
+        {
+        return format_argument{value, &format_characters, &measure_characters};
+        }
+      else if constexpr(meta::is_formatable<ValueType>::value)
+        {
+        using formatable = formatter_formatable<ValueType>;
+        return format_argument{std::addressof(value), &formatable::format, &formatable::size};
+        }
+      else
+        {
+        return format_argument{std::addressof(value), &typed_formatable<ValueType>::format, nullptr};
+        }
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Write a single value to a stream, formatted like #sophia::string::format would format it
+     *
+     * Strings are written as they are, and values with a #sophia::formatter are formatted into a buffer on the stack if their
+     * result fits. Only the results of formatters that may produce more than 64 characters are staged in a string.
+     */
+    template<typename ValueType>
+    void write_formatted(std::ostream & stream, ValueType const & value)
+      {
+      if constexpr(std::is_array<ValueType>::value && std::is_same<std::remove_extent_t<ValueType>, char>::value)
+        {
+        stream.write(value, static_cast<std::streamsize>(std::strlen(value)));
+        }
+      else if constexpr(std::is_same<std::remove_cv_t<ValueType>, char const *>::value ||
+                        std::is_same<std::remove_cv_t<ValueType>, char *>::value)
+        {
+        if(value)
+          {
+          stream.write(value, static_cast<std::streamsize>(std::strlen(value)));
+          }
+        }
+      else if constexpr(std::is_convertible<ValueType const &, std::string_view>::value)
+        {
+        auto const view = std::string_view{value};
+        stream.write(view.data(), static_cast<std::streamsize>(view.size()));
+        }
+      else if constexpr(meta::is_formatable<ValueType>::value)
+        {
+        auto formatter = sophia::formatter<ValueType>{};
+        if(static_cast<std::size_t>(formatter.max_size(value)) <= 64)
+          {
+          char buffer[64];
+          auto const last = formatter.format(value, buffer);
+          stream.write(buffer, static_cast<std::streamsize>(last - buffer));
+          }
+        else
+          {
+          auto text = std::string{};
+          auto target = format_target{text};
+          formatter_formatable<ValueType>::format(target, std::addressof(value));
+          stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+          }
+        }
+      else
+        {
+        typed_formatable<ValueType>::write(stream, std::addressof(value));
+        }
+      }
+
+    }
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A type-erased view of the arguments of a formatting operation
+   *
+   * This non-owning view is passed to #sophia::string::vformat and #sophia::string::vformat_to. It can be constructed from
+   * the array returned by #sophia::string::make_format_arguments.
+   */
+  struct format_arguments
+    {
+    template<std::size_t Size>
+    format_arguments(std::array<format_argument, Size> const & arguments)
+      : m_arguments{arguments.data()},
+        m_size{Size}
+      {
+
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Get the number of arguments
+     */
+    std::size_t size() const
+      {
+      return m_size;
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Access the argument at the given index
+     */
+    format_argument const & operator[](std::size_t index) const
+      {
+      return m_arguments[index];
+      }
+
+    private:
+      format_argument const * m_arguments;
+      std::size_t m_size;
+    };
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Capture the given values as type-erased format arguments
+   *
+   * The returned array refers to the given values and must not outlive them. It is intended to be passed directly to
+   * #sophia::string::vformat or #sophia::string::vformat_to.
+   */
+  template<typename ...ArgumentTypes>
+  std::array<format_argument, sizeof...(ArgumentTypes)> make_format_arguments(ArgumentTypes const & ...values)
+    {
+    return {{internal::erase_argument(values)...}};
+    }
+
+  namespace internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Append the result of formatting the given type-erased arguments to a string, without recording a probe
+     *
+     * This function implements #sophia::string::vformat_to. It is also used by #sophia::io::vprintf, which records the call
+     * with its own probe instead.
+     *
+     * @return The number of times @p output had to be reallocated
+     */
+    inline std::size_t vformat_to(std::string & output, std::string_view format, format_arguments arguments)
+      {
+      auto estimate = format.size();
+      for(auto index = 0ull; index < arguments.size(); ++index)
+        {
+        if(arguments[index].size)
+          {
+          estimate += arguments[index].size(arguments[index].value);
+          }
+        }
+      auto const reserved = reserve(output, output.size() + estimate);
+      auto const reserved_capacity = output.capacity();
+
+      auto target = format_target{output};
+      parse_format(format,
+                   arguments.size(),
+                   [&](std::string_view text){ output.append(text); },
+                   [&](std::size_t index, std::string_view placeholder){
+                     try
+                       {
+                       arguments[index].format(target, arguments[index].value);
+                       }
+                     catch(...)
+                       {
+                       output.append(placeholder);
+                       }
+                   });
+
+      return reserved + (output.capacity() != reserved_capacity);
+      }
+
+    }
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Append the result of formatting the given type-erased arguments to a string
+   *
+   * This function is the non-template core of #sophia::string::format. All format calls share this single implementation,
+   * regardless of the types of their arguments. Before formatting, space for the format string and the arguments that
+   * report their size is reserved in @p output. If @p output is too small, its capacity is at least doubled, so that
+   * repeatedly appending to the same string only reallocates a logarithmic number of times. If formatting an argument
+   * throws, its placeholder is copied to @p output instead.
+   *
+   * @param output The string to append to
+   * @param format A python like format-string using {#} as placeholders, where # is the index of the parameter to format.
+   * @param arguments The type-erased values to substitute for the placeholders.
+   */
+  inline void vformat_to(std::string & output, std::string_view format, format_arguments arguments)
+    {
+    auto probe = instrument::scope{instrument::probe::format};
+    auto const initial_size = output.size();
+    auto const allocations = internal::vformat_to(output, format, arguments);
+
+    if constexpr(instrument::enabled)
+      {
+      probe.produced(output.size() - initial_size);
+      probe.allocated(allocations);
+      }
+    }
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Format the given type-erased arguments
+   *
+   * @param format A python like format-string using {#} as placeholders, where # is the index of the parameter to format.
+   * @param arguments The type-erased values to substitute for the placeholders.
+   */
+  inline std::string vformat(std::string_view format, format_arguments arguments)
+    {
+    auto output = std::string{};
+    vformat_to(output, format, arguments);
+    return output;
     }
 
   /**
@@ -150,6 +684,8 @@ namespace sophia::string
    * inspired by the Python format syntax. The parameters are "addressable" in the format string. Addressing an invalid
    * argument index causes the original placeholder to be formatted.
    *
+   * This function only captures its arguments and forwards them to the type-erased #sophia::string::vformat.
+   *
    * @par Example:
    * @rst
    * .. code-block:: c++
@@ -169,54 +705,29 @@ namespace sophia::string
    * @since 0.2
    */
   template<typename ...ArgumentTypes>
-  std::string format(std::string const & format, ArgumentTypes const & ...values)
+  std::string format(std::string_view format, ArgumentTypes const & ...values)
     {
-    std::array<std::unique_ptr<internal::formatable>, sizeof...(values)> elements{
-      {std::make_unique<internal::typed_formatable<ArgumentTypes>>(values)...}
-      };
-
-    auto opening = 0ull;
-    auto closing = 0ull;
-    auto lastpos = -1ull;
-
-    auto && stream = std::ostringstream{};
-    while((opening = format.find("{", closing)) != std::string::npos)
-      {
-      closing = format.find("}", opening);
-      auto placeholder = std::string{};
-
-      if(closing != std::string::npos)
-        {
-        stream << format.substr(lastpos + 1, opening - lastpos - 1);
-        placeholder = format.substr(opening + 1, closing - opening);
-        lastpos = closing;
-        }
-      else
-        {
-        break;
-        }
-
-      try
-        {
-        auto idx = std::stoull(placeholder);
-        if(idx >= elements.size() || idx < 0)
-          {
-          stream << '{' << idx << '}';
-          }
-        else
-          {
-          elements[idx]->format(stream);
-          }
-        }
-      catch(...)
-        {
-        stream << '{' << placeholder << '}';
-        }
-
-      }
+    return vformat(format, make_format_arguments(values...));
+    }
 
-    stream << format.substr(lastpos + 1);
-    return stream.str();
+  /**
+   * @ingroup sophia_io
+   *
+   * @brief A type-safe implementation of string formatting, appending to an existing string
+   *
+   * This function behaves like #sophia::string::format, but appends the result to the given string instead of creating a
+   * new one. This makes it possible to reuse the capacity of @p output across multiple calls.
+   *
+   * @param output The string to append to
+   * @param format A python like format-string using {#} as placeholders, where # is the index of the parameter to format.
+   * @param values The values to substitute for the placeholders.
+   * @author Felix Morgner
+   * @since 0.3
+   */
+  template<typename ...ArgumentTypes>
+  void format_to(std::string & output, std::string_view format, ArgumentTypes const & ...values)
+    {
+    vformat_to(output, format, make_format_arguments(values...));
     }
 
   }
@@ -0,0 +1,299 @@
+#ifndef SOPHIA_STRING__FORMAT_BATCH
+#define SOPHIA_STRING__FORMAT_BATCH
+
+#include "sophia/string/format.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sophia::string
+  {
+
+  namespace internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief The number of records formatted by a worker before its output is handed to the sink
+     */
+    constexpr std::size_t batch_block_size{4096};
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Format the records in [first, last) into the given buffer
+     *
+     * Each record must be a tuple-like object, whose elements are used as the arguments to #sophia::string::format_to.
+     */
+    template<typename IteratorType>
+    void format_block(std::string & buffer, std::string_view format, IteratorType first, IteratorType last)
+      {
+      for(; first != last; ++first)
+        {
+        std::apply([&](auto const & ...values){ sophia::string::format_to(buffer, format, values...); }, *first);
+        }
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Format a range of records on multiple threads, handing the formatted blocks to a sink in their original order
+     *
+     * The range is divided into blocks of #batch_block_size records. Worker threads claim blocks in ascending order and
+     * format them into one of a fixed number of slot buffers. The calling thread passes the buffers to the sink in block
+     * order and recycles the slots. The amount of memory used is therefore bounded by the number of slots and does not
+     * depend on the size of the range. Exceptions thrown on a worker thread are rethrown on the calling thread. Since the
+     * blocks are claimed in order, a single iterator is advanced across the range, so that splitting a range without random
+     * access takes linear time overall.
+     *
+     * @param format The format string to apply to every record
+     * @param arguments A range of tuple-like records
+     * @param workers The number of worker threads to use. Zero selects the number of hardware threads.
+     * @param sink A callable object accepting a @p std::string @p const @p & per formatted block
+     */
+    template<typename RangeType, typename SinkType>
+    void format_batch(std::string_view format, RangeType const & arguments, std::size_t workers, SinkType && sink)
+      {
+      using std::begin;
+      using std::end;
+
+      auto position = begin(arguments);
+      auto const records = static_cast<std::size_t>(std::distance(position, end(arguments)));
+      auto const blocks = (records + batch_block_size - 1) / batch_block_size;
+
+      auto const claim = [&](std::size_t block){
+        auto const first = position;
+        std::advance(position, std::min(records - block * batch_block_size, batch_block_size));
+        return std::make_pair(first, position);
+      };
+
+      if(!workers)
+        {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+        }
+      workers = std::min(workers, blocks);
+
+      if(workers < 2)
+        {
+        auto buffer = std::string{};
+        for(auto block = 0ull; block < blocks; ++block)
+          {
+          auto const [first, last] = claim(block);
+          buffer.clear();
+          format_block(buffer, format, first, last);
+          sink(static_cast<std::string const &>(buffer));
+          }
+        return;
+        }
+
+      struct slot
+        {
+        std::string buffer{};
+        std::size_t block{};
+        bool ready{};
+        };
+
+      auto slots = std::vector<slot>(workers * 2);
+      auto mutex = std::mutex{};
+      auto produced = std::condition_variable{};
+      auto consumed = std::condition_variable{};
+      auto next = std::size_t{};
+      auto written = std::size_t{};
+      auto failure = std::exception_ptr{};
+
+      auto const work = [&]
+        {
+        for(;;)
+          {
+          auto lock = std::unique_lock<std::mutex>{mutex};
+          auto const block = next++;
+          if(block >= blocks || failure)
+            {
+            return;
+            }
+
+          auto const [first, last] = claim(block);
+          auto & current = slots[block % slots.size()];
+          consumed.wait(lock, [&]{ return block < written + slots.size() || failure; });
+          if(failure)
+            {
+            return;
+            }
+          lock.unlock();
+
+          current.buffer.clear();
+          try
+            {
+            format_block(current.buffer, format, first, last);
+            }
+          catch(...)
+            {
+            lock.lock();
+            failure = std::current_exception();
+            produced.notify_all();
+            consumed.notify_all();
+            return;
+            }
+
+          lock.lock();
+          current.block = block;
+          current.ready = true;
+          produced.notify_all();
+          }
+        };
+
+      auto threads = std::vector<std::thread>{};
+      threads.reserve(workers);
+      try
+        {
+        for(auto worker = 0ull; worker < workers; ++worker)
+          {
+          threads.emplace_back(work);
+          }
+        }
+      catch(...)
+        {
+          {
+          auto lock = std::unique_lock<std::mutex>{mutex};
+          failure = std::current_exception();
+          consumed.notify_all();
+          }
+
+        for(auto & thread : threads)
+          {
+          thread.join();
+          }
+        throw;
+        }
+
+      try
+        {
+        for(auto block = 0ull; block < blocks; ++block)
+          {
+          auto & current = slots[block % slots.size()];
+          auto lock = std::unique_lock<std::mutex>{mutex};
+          produced.wait(lock, [&]{ return (current.ready && current.block == block) || failure; });
+          if(failure)
+            {
+            break;
+            }
+          lock.unlock();
+
+          sink(static_cast<std::string const &>(current.buffer));
+
+          lock.lock();
+          current.ready = false;
+          ++written;
+          consumed.notify_all();
+          }
+        }
+      catch(...)
+        {
+        auto lock = std::unique_lock<std::mutex>{mutex};
+        failure = std::current_exception();
+        consumed.notify_all();
+        }
+
+      for(auto & thread : threads)
+        {
+        thread.join();
+        }
+
+      if(failure)
+        {
+        std::rethrow_exception(failure);
+        }
+      }
+
+    }
+
+  /**
+   * @ingroup sophia_io
+   *
+   * @brief Format a range of argument tuples with the same format string using multiple threads
+   *
+   * This function applies #sophia::string::format to every record of a range, using the elements of each record as the
+   * format arguments. The records are split into blocks, which are formatted on worker threads into per-thread buffers. The
+   * resulting output is stitched together in the original order of the records. Each record must be a tuple-like object
+   * (e.g. a std::tuple, a std::pair, or a std::array) that can be passed to std::apply. The range is traversed once to
+   * split it into blocks, so ranges without random-access iterators are supported as well.
+   *
+   * @par Example:
+   * @rst
+   * .. code-block:: c++
+   *    :linenos:
+   *
+   *    #include <sophia/string/format_batch.hpp>
+   *
+   *    #include <tuple>
+   *    #include <vector>
+   *
+   *    int main()
+   *      {
+   *      auto records = std::vector<std::tuple<int, char const *>>{{1, "one"}, {2, "two"}};
+   *      auto s = sophia::string::format_batch("{0}: {1}\n", records);
+   *      }
+   * @endrst
+   *
+   * @param format A python like format-string using {#} as placeholders, where # is the index of the parameter to format.
+   * @param arguments The range of records to format.
+   * @param workers The number of worker threads to use. Zero selects the number of hardware threads.
+   * @author Felix Morgner
+   * @since 0.3
+   */
+  template<typename RangeType>
+  std::string format_batch(std::string_view format, RangeType const & arguments, std::size_t workers = 0)
+    {
+    auto output = std::string{};
+    internal::format_batch(format, arguments, workers, [&](std::string const & block){ output += block; });
+    return output;
+    }
+
+  /**
+   * @ingroup sophia_io
+   *
+   * @brief Format a range of argument tuples with the same format string using multiple threads, writing to a stream
+   *
+   * This function behaves like #format_batch, but writes the formatted blocks to the given stream as soon as they become
+   * available in order. The memory used for buffering is bounded by the number of worker threads and does not depend on the
+   * size of the range.
+   *
+   * @param stream The stream to write to. Must be descendent from std::ostream.
+   * @param format A python like format-string using {#} as placeholders, where # is the index of the parameter to format.
+   * @param arguments The range of records to format.
+   * @param workers The number of worker threads to use. Zero selects the number of hardware threads.
+   * @author Felix Morgner
+   * @since 0.3
+   */
+  template<typename StreamType,
+           typename RangeType,
+           typename = std::enable_if_t<std::is_base_of<std::ostream, StreamType>::value, void>>
+  void format_batch(StreamType & stream, std::string_view format, RangeType const & arguments, std::size_t workers = 0)
+    {
+    internal::format_batch(format, arguments, workers, [&](std::string const & block){
+      stream.write(block.data(), static_cast<std::streamsize>(block.size()));
+    });
+    }
+
+  }
+
+#endif
@@ -0,0 +1,282 @@
+#ifndef SOPHIA_STRING__FORMATTER
+#define SOPHIA_STRING__FORMATTER
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+namespace sophia
+  {
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The customization point for formatting objects of a type without using std::ostream
+   *
+   * This class template can be specialized for user-defined types to make #sophia::string::format, #sophia::io::printf, and
+   * their friends write objects of that type directly into a character buffer. Types with a suitable specialization are
+   * preferred over types implementing @p operator<<(std::ostream &, Type const &), which is used as a fallback. A
+   * specialization must be default constructible and provide the following two member functions, both of which may be
+   * static:
+   *
+   * - @p std::size_t @p max_size(Type @p const @p &) must return an upper bound of the number of characters that will be
+   *   written for the given object. The formatting functions use it to reserve space in advance.
+   * - @p char @p * @p format(Type @p const @p &, @p char @p *) must write the characters representing the given object to
+   *   the given buffer and return a pointer past the last character written. It may be a template accepting arbitrary
+   *   output iterators.
+   *
+   * @par Example:
+   * @rst
+   * .. code-block:: c++
+   *    :linenos:
+   *
+   *    #include <sophia/string/format.hpp>
+   *
+   *    #include <algorithm>
+   *
+   *    struct point { int x; int y; };
+   *
+   *    template<>
+   *    struct sophia::formatter<point>
+   *      {
+   *      static std::size_t max_size(point const &) { return 2 * formatter<int>::max_size(0) + 4; }
+   *
+   *      template<typename OutputIterator>
+   *      static OutputIterator format(point const & value, OutputIterator out)
+   *        {
+   *        *out++ = '(';
+   *        out = formatter<int>::format(value.x, out);
+   *        *out++ = ',';
+   *        *out++ = ' ';
+   *        out = formatter<int>::format(value.y, out);
+   *        *out++ = ')';
+   *        return out;
+   *        }
+   *      };
+   * @endrst
+   *
+   * @tparam Type The type of the objects to format
+   */
+  template<typename Type, typename = void>
+  struct formatter;
+
+  namespace string::internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Copy a sequence of characters to an output iterator
+     */
+    template<typename OutputIterator>
+    OutputIterator copy_characters(std::string_view characters, OutputIterator out)
+      {
+      if constexpr(std::is_same<OutputIterator, char *>::value)
+        {
+        std::memcpy(out, characters.data(), characters.size());
+        return out + characters.size();
+        }
+      else
+        {
+        return std::copy(characters.begin(), characters.end(), out);
+        }
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Format an arithmetic value via std::to_chars, using a temporary buffer for output iterators other than char *
+     */
+    template<typename ValueType, std::size_t MaxSize, typename OutputIterator, typename ...OptionTypes>
+    OutputIterator convert_characters(ValueType value, OutputIterator out, OptionTypes ...options)
+      {
+      if constexpr(std::is_same<OutputIterator, char *>::value)
+        {
+        return std::to_chars(out, out + MaxSize, value, options...).ptr;
+        }
+      else
+        {
+        char buffer[MaxSize];
+        auto const last = std::to_chars(buffer, buffer + MaxSize, value, options...).ptr;
+        return std::copy(buffer, last, out);
+        }
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Check if a type is formatted as a single character
+     */
+    template<typename Type>
+    using is_character = std::disjunction<
+      std::is_same<Type, char>,
+      std::is_same<Type, signed char>,
+      std::is_same<Type, unsigned char>
+    >;
+
+    }
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The formatter for integral types other than bool and character types
+   *
+   * Integers are formatted in decimal notation, like @p std::ostream does by default.
+   */
+  template<typename Type>
+  struct formatter<Type, std::enable_if_t<std::is_integral<Type>::value &&
+                                          !std::is_same<Type, bool>::value &&
+                                          !string::internal::is_character<Type>::value>>
+    {
+    static constexpr std::size_t max_size(Type const &)
+      {
+      return std::numeric_limits<Type>::digits10 + 2;
+      }
+
+    template<typename OutputIterator>
+    static OutputIterator format(Type const & value, OutputIterator out)
+      {
+      return string::internal::convert_characters<Type, std::numeric_limits<Type>::digits10 + 2>(value, out);
+      }
+    };
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The formatter for floating point types
+   *
+   * Floating point numbers are formatted using the shortest of fixed and scientific notation with six significant digits,
+   * like @p std::ostream does by default.
+   */
+  template<typename Type>
+  struct formatter<Type, std::enable_if_t<std::is_floating_point<Type>::value>>
+    {
+    static constexpr std::size_t max_size(Type const &)
+      {
+      return 32;
+      }
+
+    template<typename OutputIterator>
+    static OutputIterator format(Type const & value, OutputIterator out)
+      {
+      return string::internal::convert_characters<Type, 32>(value, out, std::chars_format::general, 6);
+      }
+    };
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The formatter for bool
+   *
+   * Boolean values are formatted as @p 1 or @p 0, like @p std::ostream does by default.
+   */
+  template<>
+  struct formatter<bool>
+    {
+    static constexpr std::size_t max_size(bool const &)
+      {
+      return 1;
+      }
+
+    template<typename OutputIterator>
+    static OutputIterator format(bool const & value, OutputIterator out)
+      {
+      *out++ = value ? '1' : '0';
+      return out;
+      }
+    };
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The formatter for character types
+   */
+  template<typename Type>
+  struct formatter<Type, std::enable_if_t<string::internal::is_character<Type>::value>>
+    {
+    static constexpr std::size_t max_size(Type const &)
+      {
+      return 1;
+      }
+
+    template<typename OutputIterator>
+    static OutputIterator format(Type const & value, OutputIterator out)
+      {
+      *out++ = static_cast<char>(value);
+      return out;
+      }
+    };
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The formatter for null-terminated character strings
+   *
+   * A null pointer is formatted as an empty string.
+   */
+  template<typename Type>
+  struct formatter<Type, std::enable_if_t<std::is_same<std::remove_cv_t<Type>, char const *>::value ||
+                                          std::is_same<std::remove_cv_t<Type>, char *>::value>>
+    {
+    static std::size_t max_size(Type const & value)
+      {
+      return value ? std::strlen(value) : 0;
+      }
+
+    template<typename OutputIterator>
+    static OutputIterator format(Type const & value, OutputIterator out)
+      {
+      return value ? string::internal::copy_characters(value, out) : out;
+      }
+    };
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief The formatter for string-like types
+   *
+   * This formatter is used for all non-pointer types that can be converted to @p std::string_view, like @p std::string.
+   */
+  template<typename Type>
+  struct formatter<Type, std::enable_if_t<!std::is_pointer<Type>::value &&
+                                          std::is_convertible<Type const &, std::string_view>::value>>
+    {
+    static std::size_t max_size(Type const & value)
+      {
+      return std::string_view{value}.size();
+      }
+
+    template<typename OutputIterator>
+    static OutputIterator format(Type const & value, OutputIterator out)
+      {
+      return string::internal::copy_characters(std::string_view{value}, out);
+      }
+    };
+
+  }
+
+#endif
@@ -0,0 +1,362 @@
+#ifndef SOPHIA_STRING__STATIC_FORMAT
+#define SOPHIA_STRING__STATIC_FORMAT
+
+#include "sophia/string/format.hpp"
+
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace sophia::string
+  {
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief A string of fixed capacity that can be constructed and manipulated in constant expressions
+   *
+   * Objects of this type are produced by #sophia::string::static_format. The characters are stored inline and are always
+   * followed by a terminating null character.
+   *
+   * @tparam Capacity The maximum number of characters the string can hold
+   */
+  template<std::size_t Capacity>
+  struct fixed_string
+    {
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Construct a new empty fixed_string
+     */
+    constexpr fixed_string() = default;
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Append a single character
+     *
+     * @throws std::length_error if the string is already filled to its capacity
+     */
+    constexpr void push_back(char character)
+      {
+      if(m_size == Capacity)
+        {
+        throw std::length_error{"fixed_string capacity exceeded"};
+        }
+
+      m_data[m_size++] = character;
+      m_data[m_size] = '\0';
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Append a sequence of characters
+     *
+     * @throws std::length_error if the characters do not fit into the string
+     */
+    constexpr void append(std::string_view characters)
+      {
+      for(auto character : characters)
+        {
+        push_back(character);
+        }
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Get the number of characters in the string
+     */
+    constexpr std::size_t size() const
+      {
+      return m_size;
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Get the maximum number of characters the string can hold
+     */
+    static constexpr std::size_t capacity()
+      {
+      return Capacity;
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Access the null-terminated characters of the string
+     */
+    constexpr char const * c_str() const
+      {
+      return m_data;
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Access the characters of the string
+     */
+    constexpr char const * data() const
+      {
+      return m_data;
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Get a view of the characters of the string
+     */
+    constexpr std::string_view view() const
+      {
+      return {m_data, m_size};
+      }
+
+    /**
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Get a view of the characters of the string
+     */
+    constexpr operator std::string_view() const
+      {
+      return view();
+      }
+
+    private:
+      char m_data[Capacity + 1]{};
+      std::size_t m_size{};
+    };
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Compare a fixed_string to a sequence of characters
+   */
+  template<std::size_t Capacity>
+  constexpr bool operator==(fixed_string<Capacity> const & lhs, std::string_view rhs)
+    {
+    return lhs.view() == rhs;
+    }
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Compare a fixed_string to a sequence of characters
+   */
+  template<std::size_t Capacity>
+  constexpr bool operator!=(fixed_string<Capacity> const & lhs, std::string_view rhs)
+    {
+    return !(lhs == rhs);
+    }
+
+  /**
+   * @ingroup sophia_io
+   * @author Felix Morgner
+   * @since 0.3
+   *
+   * @brief Write a fixed_string to a stream
+   */
+  template<std::size_t Capacity>
+  std::ostream & operator<<(std::ostream & stream, fixed_string<Capacity> const & string)
+    {
+    return stream << string.view();
+    }
+
+  namespace internal
+    {
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief A uniform representation of the arguments supported by #sophia::string::static_format
+     */
+    struct static_argument
+      {
+      enum struct kind
+        {
+        signed_integer,
+        unsigned_integer,
+        character,
+        text,
+        };
+
+      kind type{};
+      long long signed_value{};
+      unsigned long long unsigned_value{};
+      std::string_view text{};
+      };
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Convert an argument of #sophia::string::static_format into its uniform representation
+     */
+    template<typename ValueType>
+    constexpr static_argument make_static_argument(ValueType const & value)
+      {
+      using kind = static_argument::kind;
+
+      if constexpr(is_character<ValueType>::value)
+        {
+        return {kind::character, static_cast<char>(value), 0, {}};
+        }
+      else if constexpr(std::is_same<ValueType, bool>::value)
+        {
+        return {kind::unsigned_integer, 0, value ? 1u : 0u, {}};
+        }
+      else if constexpr(std::is_integral<ValueType>::value && std::is_signed<ValueType>::value)
+        {
+        return {kind::signed_integer, value, 0, {}};
+        }
+      else if constexpr(std::is_integral<ValueType>::value)
+        {
+        return {kind::unsigned_integer, 0, value, {}};
+        }
+      else if constexpr(std::is_enum<ValueType>::value && std::is_convertible<ValueType, long long>::value)
+        {
+        return make_static_argument(static_cast<std::underlying_type_t<ValueType>>(value));
+        }
+      else if constexpr(std::is_convertible<ValueType const &, std::string_view>::value)
+        {
+        return {kind::text, 0, 0, std::string_view{value}};
+        }
+      else
+        {
+        static_assert(std::is_convertible<ValueType const &, std::string_view>::value,
+                      "static_format only supports integral, character, and string arguments");
+        return {};
+        }
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Append the decimal representation of an unsigned integer
+     */
+    template<std::size_t Capacity>
+    constexpr void append_decimal(fixed_string<Capacity> & output, unsigned long long value)
+      {
+      char digits[20]{};
+      auto count = std::size_t{};
+
+      do
+        {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+        }
+      while(value);
+
+      while(count)
+        {
+        output.push_back(digits[--count]);
+        }
+      }
+
+    /**
+     * @internal
+     * @author Felix Morgner
+     * @since 0.3
+     *
+     * @brief Append the representation of a static_argument
+     */
+    template<std::size_t Capacity>
+    constexpr void append_argument(fixed_string<Capacity> & output, static_argument const & argument)
+      {
+      using kind = static_argument::kind;
+
+      switch(argument.type)
+        {
+        case kind::signed_integer:
+          if(argument.signed_value < 0)
+            {
+            output.push_back('-');
+            append_decimal(output, 0ull - static_cast<unsigned long long>(argument.signed_value));
+            }
+          else
+            {
+            append_decimal(output, static_cast<unsigned long long>(argument.signed_value));
+            }
+          break;
+        case kind::unsigned_integer:
+          append_decimal(output, argument.unsigned_value);
+          break;
+        case kind::character:
+          output.push_back(static_cast<char>(argument.signed_value));
+          break;
+        case kind::text:
+          output.append(argument.text);
+          break;
+        }
+      }
+
+    }
+
+  /**
+   * @ingroup sophia_io
+   *
+   * @brief A type-safe implementation of string formatting that can be evaluated at compile-time
+   *
+   * This function implements the same format syntax as #sophia::string::format, but can be used in constant expressions.
+   * When the format string and all arguments are constant expressions, the result is computed at compile-time and can be
+   * stored in a @p constexpr variable, so the formatting has no runtime cost at all. The supported argument types are
+   * integral types (including unscoped enumerations), character types, and anything that is convertible to
+   * @p std::string_view in a constant expression, like string literals or other #sophia::string::fixed_string objects.
+   *
+   * @par Example:
+   * @rst
+   * .. code-block:: c++
+   *    :linenos:
+   *
+   *    #include <sophia/string/static_format.hpp>
+   *
+   *    constexpr auto version = sophia::string::static_format<16>("v{0}.{1}.{2}", 1, 4, 2);
+   *    static_assert(version == "v1.4.2");
+   * @endrst
+   *
+   * @tparam Capacity The maximum number of characters of the result
+   * @param format A python like format-string using {#} as placeholders, where # is the index of the parameter to format.
+   * @param values The values to substitute for the placeholders.
+   * @throws std::length_error if the result exceeds @p Capacity characters. In a constant expression, this makes the program
+   *         ill-formed.
+   * @author Felix Morgner
+   * @since 0.3
+   */
+  template<std::size_t Capacity = 256, typename ...ArgumentTypes>
+  constexpr fixed_string<Capacity> static_format(std::string_view format, ArgumentTypes const & ...values)
+    {
+    internal::static_argument const arguments[sizeof...(values) + 1]{internal::make_static_argument(values)...};
+    auto output = fixed_string<Capacity>{};
+    internal::parse_format(format,
+                           sizeof...(values),
+                           [&](std::string_view text){ output.append(text); },
+                           [&](std::size_t index, std::string_view){ internal::append_argument(output, arguments[index]); });
+    return output;
+    }
+
+  }
+
+#endif
@@ -14,5 +14,7 @@
  */
 
 #include "sophia/string/format.hpp"
+#include "sophia/string/format_batch.hpp"
+#include "sophia/string/static_format.hpp"
 
 #endif
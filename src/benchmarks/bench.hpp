@@ -0,0 +1,147 @@
+#ifndef SOPHIA_BENCHMARKS__BENCH
+#define SOPHIA_BENCHMARKS__BENCH
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench
+  {
+
+  /**
+   * @brief Prevent the compiler from optimizing away the computation of the given value
+   */
+  template<typename ValueType>
+  inline void keep(ValueType const & value)
+    {
+    asm volatile("" : : "r"(&value) : "memory");
+    }
+
+  /**
+   * @brief Prevent the compiler from assuming anything about the given value
+   */
+  template<typename ValueType>
+  inline void clobber(ValueType & value)
+    {
+    asm volatile("" : "+m"(value) : : "memory");
+    }
+
+  /**
+   * @brief The body of a benchmark case
+   *
+   * The body must perform the measured operation @p iterations times and return the number of bytes it produced or consumed
+   * in total, or zero if a throughput figure does not make sense for the case.
+   */
+  using body = std::function<std::size_t (std::size_t iterations)>;
+
+  /**
+   * @brief The untimed preparation of a benchmark case
+   *
+   * If present, it is called with the iteration count before every timed run of the body. It can be used to set up state
+   * that the body consumes, and to tear down the state left behind by the previous run, outside the timed region.
+   */
+  using setup = std::function<void (std::size_t iterations)>;
+
+  /**
+   * @brief A single benchmark case
+   */
+  struct benchmark
+    {
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> parameters;
+    body run;
+    setup prepare{};
+    };
+
+  /**
+   * @brief The result of running a single benchmark case
+   */
+  struct result
+    {
+    benchmark const * source;
+    std::size_t iterations;
+    std::vector<double> nanoseconds_per_operation;
+    double bytes_per_operation;
+    };
+
+  /**
+   * @brief The collection of all benchmark cases of the suite
+   */
+  struct registry
+    {
+    void add(std::string name, std::vector<std::pair<std::string, std::string>> parameters, body run, setup prepare = {})
+      {
+      m_benchmarks.push_back({std::move(name), std::move(parameters), std::move(run), std::move(prepare)});
+      }
+
+    std::vector<benchmark> const & benchmarks() const
+      {
+      return m_benchmarks;
+      }
+
+    private:
+      std::vector<benchmark> m_benchmarks{};
+    };
+
+  /**
+   * @brief Measure the given benchmark case
+   *
+   * The case is first run once without being measured, so that state set up lazily on first use, like large input data,
+   * does not distort the calibration. The number of iterations is then calibrated so that a single repetition takes at
+   * least @p min_time seconds. Finally, the case is run @p repetitions times with the calibrated iteration count. Every run
+   * is preceded by the untimed preparation of the case, if it has one.
+   */
+  inline result measure(benchmark const & benchmark, double min_time, std::size_t repetitions)
+    {
+    using clock = std::chrono::steady_clock;
+
+    auto const time = [&](std::size_t iterations, std::size_t & bytes)
+      {
+      if(benchmark.prepare)
+        {
+        benchmark.prepare(iterations);
+        }
+
+      auto const start = clock::now();
+      bytes = benchmark.run(iterations);
+      return std::chrono::duration<double>(clock::now() - start).count();
+      };
+
+    auto bytes = std::size_t{};
+    time(1, bytes);
+
+    auto iterations = std::size_t{1};
+    for(auto elapsed = time(iterations, bytes); elapsed < min_time; elapsed = time(iterations, bytes))
+      {
+      auto const factor = elapsed > 0 ? std::min(10.0, 1.2 * min_time / elapsed) : 10.0;
+      iterations = std::max(iterations + 1, static_cast<std::size_t>(iterations * factor));
+      }
+
+    auto outcome = result{&benchmark, iterations, {}, 0};
+    for(auto repetition = 0ull; repetition < repetitions; ++repetition)
+      {
+      outcome.nanoseconds_per_operation.push_back(time(iterations, bytes) * 1e9 / iterations);
+      }
+
+    outcome.bytes_per_operation = static_cast<double>(bytes) / iterations;
+    std::sort(outcome.nanoseconds_per_operation.begin(), outcome.nanoseconds_per_operation.end());
+    return outcome;
+    }
+
+  void register_format(registry & registry);
+  void register_write(registry & registry);
+  void register_flat_hash_map(registry & registry);
+  void register_small_vector(registry & registry);
+  void register_executor(registry & registry);
+  void register_generator(registry & registry);
+  void register_guard(registry & registry);
+  void register_instrument(registry & registry);
+  void register_record(registry & registry);
+
+  }
+
+#endif
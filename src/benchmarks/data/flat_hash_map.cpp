@@ -0,0 +1,270 @@
+#include "bench.hpp"
+
+#include "sophia/data/flat_hash_map.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+  {
+
+  /**
+   * @brief The largest key count to benchmark, read from the environment variable SOPHIA_BENCH_HASH_MAX_KEYS
+   *
+   * The key counts range from 1K to 100M in steps of ten. The largest tables need several gigabytes of memory, so by
+   * default only tables of up to 1M keys are benchmarked.
+   */
+  std::size_t max_keys()
+    {
+    auto const configured = std::getenv("SOPHIA_BENCH_HASH_MAX_KEYS");
+    return configured ? std::strtoull(configured, nullptr, 10) : 1000000;
+    }
+
+  std::string count_name(std::size_t count)
+    {
+    return count >= 1000000 ? std::to_string(count / 1000000) + "M" : std::to_string(count / 1000) + "K";
+    }
+
+  std::string make_key(std::string const &, char prefix, std::uint64_t number)
+    {
+    return prefix + std::to_string(number & 0xffffffffu);
+    }
+
+  std::uint64_t make_key(std::uint64_t, char prefix, std::uint64_t number)
+    {
+    return prefix == 'k' ? number | 1 : number & ~std::uint64_t{1};
+    }
+
+  /**
+   * @brief The keys of a benchmark, generated on first use
+   *
+   * The present keys are inserted in one random order and looked up in another. The absent keys are guaranteed not to
+   * collide with the present keys.
+   */
+  template<typename KeyType>
+  struct key_set
+    {
+    explicit key_set(std::size_t count)
+      : m_count{count}
+      {
+
+      }
+
+    void generate()
+      {
+      if(!present.empty())
+        {
+        return;
+        }
+
+      auto engine = std::mt19937_64{m_count};
+      auto seen = std::unordered_map<KeyType, bool>{};
+      seen.reserve(m_count);
+      while(present.size() < m_count)
+        {
+        auto key = make_key(KeyType{}, 'k', engine());
+        if(seen.emplace(key, true).second)
+          {
+          present.push_back(std::move(key));
+          }
+        }
+
+      lookups = present;
+      std::shuffle(lookups.begin(), lookups.end(), engine);
+
+      absent.reserve(m_count);
+      for(auto index = 0ull; index < m_count; ++index)
+        {
+        absent.push_back(make_key(KeyType{}, 'm', engine()));
+        }
+      }
+
+    std::vector<KeyType> present{};
+    std::vector<KeyType> lookups{};
+    std::vector<KeyType> absent{};
+
+    private:
+      std::size_t m_count;
+    };
+
+  /**
+   * @brief A table filled with the present keys of a key set, built on first use and shared between benchmark cases
+   */
+  template<typename MapType, typename KeyType>
+  struct filled_table
+    {
+    MapType & get(key_set<KeyType> & keys)
+      {
+      if(!m_table)
+        {
+        keys.generate();
+        m_table = std::make_unique<MapType>();
+        for(auto index = 0ull; index < keys.present.size(); ++index)
+          {
+          m_table->emplace(keys.present[index], index);
+          }
+        }
+      return *m_table;
+      }
+
+    private:
+      std::unique_ptr<MapType> m_table{};
+    };
+
+  /**
+   * @brief A table that is filled with the present keys of a key set by the insert benchmark
+   *
+   * Once the table holds all keys, it is retired and replaced by an empty one, so that every insertion hits a table of the
+   * same size as in a real fill. Retiring a table only moves it, and the retired tables are destroyed in the untimed
+   * preparation of the next run.
+   */
+  template<typename MapType>
+  struct growing_table
+    {
+    MapType table{};
+    std::vector<MapType> retired{};
+    std::size_t cursor{};
+    };
+
+  /**
+   * @brief Look up a string key given as a std::string_view
+   *
+   * The flat hash map supports heterogeneous lookup with its default hasher. std::unordered_map only does so since C++20,
+   * so it has to construct a std::string first, which is exactly the cost heterogeneous lookup avoids.
+   */
+  template<typename MapType>
+  auto find_view(MapType const & map, std::string_view key)
+    {
+    if constexpr(std::is_same<MapType, std::unordered_map<std::string, std::size_t>>::value)
+      {
+      return map.find(std::string{key});
+      }
+    else
+      {
+      return map.find(key);
+      }
+    }
+
+  template<typename MapType, typename KeyType>
+  void register_cases(bench::registry & registry,
+                      std::string const & implementation,
+                      std::string const & key_name,
+                      std::size_t count,
+                      std::shared_ptr<key_set<KeyType>> keys)
+    {
+    auto const table = std::make_shared<filled_table<MapType, KeyType>>();
+    auto const prefix = "hash_map/" + key_name + "/" + count_name(count) + "/";
+    auto const parameters = [&](char const * operation){
+      return std::vector<std::pair<std::string, std::string>>{
+        {"implementation", implementation},
+        {"key", key_name},
+        {"keys", std::to_string(count)},
+        {"operation", operation},
+      };
+    };
+
+    auto const growing = std::make_shared<growing_table<MapType>>();
+    registry.add(prefix + "insert/" + implementation, parameters("insert"), [=](std::size_t iterations) {
+      auto & state = *growing;
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        if(state.cursor == count)
+          {
+          state.retired.push_back(std::move(state.table));
+          state.table = MapType{};
+          state.cursor = 0;
+          }
+        state.table.emplace(keys->present[state.cursor], state.cursor);
+        ++state.cursor;
+        }
+      bench::keep(state.table);
+      return std::size_t{};
+    }, [=](std::size_t) {
+      keys->generate();
+      growing->retired.clear();
+    });
+
+    registry.add(prefix + "hit/" + implementation, parameters("hit"), [=, cursor = std::size_t{}](std::size_t iterations) mutable {
+      auto const & map = table->get(*keys);
+      auto found = std::size_t{};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        found += map.find(keys->lookups[cursor])->second;
+        cursor = cursor + 1 == count ? 0 : cursor + 1;
+        }
+      bench::keep(found);
+      return std::size_t{};
+    });
+
+    if constexpr(std::is_same<KeyType, std::string>::value)
+      {
+      registry.add(prefix + "hit_view/" + implementation, parameters("hit via string_view"), [=, cursor = std::size_t{}](std::size_t iterations) mutable {
+        auto const & map = table->get(*keys);
+        auto found = std::size_t{};
+        for(auto iteration = 0ull; iteration < iterations; ++iteration)
+          {
+          found += find_view(map, std::string_view{keys->lookups[cursor]})->second;
+          cursor = cursor + 1 == count ? 0 : cursor + 1;
+          }
+        bench::keep(found);
+        return std::size_t{};
+      });
+      }
+
+    registry.add(prefix + "miss/" + implementation, parameters("miss"), [=, cursor = std::size_t{}](std::size_t iterations) mutable {
+      auto const & map = table->get(*keys);
+      auto found = std::size_t{};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        found += map.find(keys->absent[cursor]) != map.end();
+        cursor = cursor + 1 == count ? 0 : cursor + 1;
+        }
+      bench::keep(found);
+      return std::size_t{};
+    });
+
+    registry.add(prefix + "erase/" + implementation, parameters("erase+reinsert"), [=, cursor = std::size_t{}](std::size_t iterations) mutable {
+      auto & map = table->get(*keys);
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        map.erase(keys->lookups[cursor]);
+        map.emplace(keys->lookups[cursor], cursor);
+        cursor = cursor + 1 == count ? 0 : cursor + 1;
+        }
+      bench::keep(map);
+      return std::size_t{};
+    });
+    }
+
+  template<typename KeyType>
+  void register_key_type(bench::registry & registry, std::string const & key_name)
+    {
+    for(auto count = std::size_t{1000}; count <= max_keys() && count <= 100000000; count *= 10)
+      {
+      auto const keys = std::make_shared<key_set<KeyType>>(count);
+      register_cases<sophia::data::flat_hash_map<KeyType, std::size_t>>(registry, "sophia::data::flat_hash_map", key_name, count, keys);
+      register_cases<std::unordered_map<KeyType, std::size_t>>(registry, "std::unordered_map", key_name, count, keys);
+      }
+    }
+
+  }
+
+namespace bench
+  {
+
+  void register_flat_hash_map(registry & registry)
+    {
+    register_key_type<std::string>(registry, "string");
+    register_key_type<std::uint64_t>(registry, "uint64");
+    }
+
+  }
@@ -0,0 +1,177 @@
+#include "bench.hpp"
+
+#include "sophia/data/small_vector.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+  {
+
+  constexpr auto inline_capacity = std::size_t{16};
+
+  /**
+   * @brief The number of allocations performed through any counting_allocator
+   */
+  std::size_t allocations{};
+
+  /**
+   * @brief An allocator that counts the allocations it performs
+   */
+  template<typename ValueType>
+  struct counting_allocator : std::allocator<ValueType>
+    {
+    using value_type = ValueType;
+
+    template<typename OtherType>
+    struct rebind
+      {
+      using other = counting_allocator<OtherType>;
+      };
+
+    counting_allocator() = default;
+
+    template<typename OtherType>
+    counting_allocator(counting_allocator<OtherType> const &) noexcept
+      {
+
+      }
+
+    ValueType * allocate(std::size_t count)
+      {
+      ++allocations;
+      return std::allocator<ValueType>::allocate(count);
+      }
+    };
+
+  template<typename ValueType>
+  using small = sophia::data::small_vector<ValueType, inline_capacity, counting_allocator<ValueType>>;
+
+  template<typename ValueType>
+  using standard = std::vector<ValueType, counting_allocator<ValueType>>;
+
+  int make_value(int, std::size_t index)
+    {
+    return static_cast<int>(index);
+    }
+
+  std::string make_value(std::string, std::size_t index)
+    {
+    return "token-" + std::to_string(index);
+    }
+
+  /**
+   * @brief Wrap a benchmark body so that it aborts if the small_vector under test allocates while staying inline
+   */
+  template<typename ContainerType, typename BodyType>
+  bench::body checked(std::string const & name, std::size_t size, BodyType run)
+    {
+    if constexpr(std::is_same<ContainerType, small<typename ContainerType::value_type>>::value)
+      {
+      if(size <= inline_capacity)
+        {
+        return [=](std::size_t iterations) {
+          auto const before = allocations;
+          auto const bytes = run(iterations);
+          if(allocations != before)
+            {
+            std::cerr << name << ": " << allocations - before << " allocations below the inline capacity\n";
+            std::abort();
+            }
+          return bytes;
+        };
+        }
+      }
+    return run;
+    }
+
+  template<typename ContainerType>
+  void register_cases(bench::registry & registry, std::string const & implementation, std::string const & element, std::size_t size)
+    {
+    using value_type = typename ContainerType::value_type;
+
+    auto const prefix = "small_vector/" + element + "/" + std::to_string(size) + "/";
+    auto const parameters = [&](char const * operation){
+      return std::vector<std::pair<std::string, std::string>>{
+        {"implementation", implementation},
+        {"element", element},
+        {"size", std::to_string(size)},
+        {"inline_capacity", std::to_string(inline_capacity)},
+        {"operation", operation},
+      };
+    };
+
+    auto const values = std::make_shared<std::vector<value_type>>();
+    for(auto index = 0ull; index < size; ++index)
+      {
+      values->push_back(make_value(value_type{}, index));
+      }
+
+    auto name = prefix + "push_back/" + implementation;
+    registry.add(name, parameters("push_back"), checked<ContainerType>(name, size, [=](std::size_t iterations) {
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        auto container = ContainerType{};
+        for(auto const & value : *values)
+          {
+          container.push_back(value);
+          }
+        bench::keep(container);
+        }
+      return std::size_t{};
+    }));
+
+    auto const source = std::make_shared<ContainerType>(values->begin(), values->end());
+    name = prefix + "copy/" + implementation;
+    registry.add(name, parameters("copy"), checked<ContainerType>(name, size, [=](std::size_t iterations) {
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        auto container = *source;
+        bench::keep(container);
+        }
+      return std::size_t{};
+    }));
+
+    name = prefix + "insert/" + implementation;
+    registry.add(name, parameters("insert"), checked<ContainerType>(name, size, [=](std::size_t iterations) {
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        auto container = ContainerType{};
+        for(auto const & value : *values)
+          {
+          container.insert(container.begin(), value);
+          }
+        bench::keep(container);
+        }
+      return std::size_t{};
+    }));
+    }
+
+  template<typename ValueType>
+  void register_element_type(bench::registry & registry, std::string const & element)
+    {
+    for(auto size : {std::size_t{4}, inline_capacity, inline_capacity * 4})
+      {
+      register_cases<small<ValueType>>(registry, "sophia::data::small_vector", element, size);
+      register_cases<standard<ValueType>>(registry, "std::vector", element, size);
+      }
+    }
+
+  }
+
+namespace bench
+  {
+
+  void register_small_vector(registry & registry)
+    {
+    register_element_type<int>(registry, "int");
+    register_element_type<std::string>(registry, "string");
+    }
+
+  }
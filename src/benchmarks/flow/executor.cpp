@@ -0,0 +1,162 @@
+#include "bench.hpp"
+
+#include "sophia/flow/executor.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+  {
+
+  constexpr auto sum_elements = std::size_t{1} << 22;
+  constexpr auto sort_elements = std::size_t{1} << 20;
+  constexpr auto sequential_cutoff = std::size_t{1} << 14;
+
+  std::uint64_t recursive_sum(sophia::flow::executor & executor, std::uint64_t const * first, std::uint64_t const * last)
+    {
+    auto const count = static_cast<std::size_t>(last - first);
+    if(count <= sequential_cutoff)
+      {
+      return std::accumulate(first, last, std::uint64_t{});
+      }
+
+    auto const middle = first + count / 2;
+    auto upper = std::uint64_t{};
+    auto group = sophia::flow::task_group{executor};
+    group.run([&]{ upper = recursive_sum(executor, middle, last); });
+    auto const lower = recursive_sum(executor, first, middle);
+    group.wait();
+    return lower + upper;
+    }
+
+  void parallel_sort(sophia::flow::executor & executor, std::uint32_t * first, std::uint32_t * last)
+    {
+    auto const count = static_cast<std::size_t>(last - first);
+    if(count <= sequential_cutoff)
+      {
+      std::sort(first, last);
+      return;
+      }
+
+    auto const middle = first + count / 2;
+    auto group = sophia::flow::task_group{executor};
+    group.run([&]{ parallel_sort(executor, middle, last); });
+    parallel_sort(executor, first, middle);
+    group.wait();
+    std::inplace_merge(first, middle, last);
+    }
+
+  std::vector<std::uint32_t> random_values(std::size_t count)
+    {
+    auto engine = std::mt19937{42};
+    auto values = std::vector<std::uint32_t>(count);
+    std::generate(values.begin(), values.end(), engine);
+    return values;
+    }
+
+  /**
+   * @brief Create a benchmark body that runs the given workload on an executor with the given number of workers
+   *
+   * The executor is created on first use, so that listing or filtering the benchmarks does not start any threads.
+   */
+  template<typename WorkloadType>
+  bench::body on_executor(std::size_t workers, WorkloadType workload)
+    {
+    auto executor = std::shared_ptr<sophia::flow::executor>{};
+    return [=](std::size_t iterations) mutable {
+      if(!executor)
+        {
+        executor = std::make_shared<sophia::flow::executor>(workers);
+        }
+      return workload(*executor, iterations);
+    };
+    }
+
+  }
+
+namespace bench
+  {
+
+  void register_executor(registry & registry)
+    {
+    auto const input = std::make_shared<std::vector<std::uint64_t>>(sum_elements);
+    std::iota(input->begin(), input->end(), std::uint64_t{});
+
+    auto const unsorted = std::make_shared<std::vector<std::uint32_t>>(random_values(sort_elements));
+
+    registry.add("executor/sum/sequential", {{"implementation", "std::accumulate"}, {"elements", "4M"}}, [=](std::size_t iterations){
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        auto sum = std::accumulate(input->begin(), input->end(), std::uint64_t{});
+        clobber(sum);
+        }
+      return iterations * sum_elements * sizeof(std::uint64_t);
+    });
+
+    registry.add("executor/sort/sequential", {{"implementation", "std::sort"}, {"elements", "1M"}}, [=](std::size_t iterations){
+      auto values = std::vector<std::uint32_t>{};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        values = *unsorted;
+        std::sort(values.begin(), values.end());
+        keep(values);
+        }
+      return iterations * sort_elements * sizeof(std::uint32_t);
+    });
+
+    for(auto workers : {1ull, 2ull, 4ull, 8ull})
+      {
+      auto const parameters = [&](std::string implementation, std::string elements){
+        return std::vector<std::pair<std::string, std::string>>{
+          {"implementation", std::move(implementation)},
+          {"elements", std::move(elements)},
+          {"workers", std::to_string(workers)},
+        };
+      };
+
+      registry.add("executor/sum/workers=" + std::to_string(workers),
+                   parameters("sophia::flow::task_group", "4M"),
+                   on_executor(workers, [=](sophia::flow::executor & executor, std::size_t iterations){
+        for(auto iteration = 0ull; iteration < iterations; ++iteration)
+          {
+          auto sum = recursive_sum(executor, input->data(), input->data() + input->size());
+          clobber(sum);
+          }
+        return iterations * sum_elements * sizeof(std::uint64_t);
+      }));
+
+      registry.add("executor/sort/workers=" + std::to_string(workers),
+                   parameters("sophia::flow::task_group", "1M"),
+                   on_executor(workers, [=](sophia::flow::executor & executor, std::size_t iterations){
+        auto values = std::vector<std::uint32_t>{};
+        for(auto iteration = 0ull; iteration < iterations; ++iteration)
+          {
+          values = *unsorted;
+          parallel_sort(executor, values.data(), values.data() + values.size());
+          keep(values);
+          }
+        return iterations * sort_elements * sizeof(std::uint32_t);
+      }));
+
+      registry.add("executor/parallel_for/workers=" + std::to_string(workers),
+                   parameters("sophia::flow::parallel_for", "4M"),
+                   on_executor(workers, [=](sophia::flow::executor & executor, std::size_t iterations){
+        auto output = std::vector<std::uint64_t>(sum_elements);
+        for(auto iteration = 0ull; iteration < iterations; ++iteration)
+          {
+          sophia::flow::parallel_for(executor, std::size_t{}, sum_elements, [&](std::size_t index){
+            output[index] = (*input)[index] * 3 + 1;
+          });
+          keep(output);
+          }
+        return iterations * sum_elements * sizeof(std::uint64_t) * 2;
+      }));
+      }
+    }
+
+  }
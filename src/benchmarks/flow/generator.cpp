@@ -0,0 +1,106 @@
+#include "bench.hpp"
+
+#include "sophia/flow/generator.hpp"
+#include "sophia/string/format.hpp"
+
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace
+  {
+
+  constexpr auto elements = std::size_t{1024};
+
+  }
+
+namespace bench
+  {
+
+  void register_generator(registry & registry)
+    {
+    using namespace sophia::flow;
+
+    registry.add("generator/pipeline", {{"implementation", "sophia::flow"}, {"elements", "1024"}}, [](std::size_t iterations){
+      auto sum = std::uint64_t{};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        auto pipeline = iota(std::uint64_t{})
+                      | map([](std::uint64_t n){ return n * n; })
+                      | filter([](std::uint64_t n){ return n % 3; })
+                      | take(elements);
+        for(auto value : pipeline)
+          {
+          sum += value;
+          }
+        clobber(sum);
+        }
+      return std::size_t{};
+    });
+
+    registry.add("generator/loop", {{"implementation", "loop"}, {"elements", "1024"}}, [](std::size_t iterations){
+      auto sum = std::uint64_t{};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        auto taken = std::size_t{};
+        for(auto n = std::uint64_t{}; taken < elements; ++n)
+          {
+          auto const square = n * n;
+          if(square % 3)
+            {
+            sum += square;
+            ++taken;
+            }
+          }
+        clobber(sum);
+        }
+      return std::size_t{};
+    });
+
+    registry.add("generator/chunk", {{"implementation", "sophia::flow"}, {"elements", "1024"}, {"chunk", "16"}}, [](std::size_t iterations){
+      auto input = std::vector<std::uint64_t>(elements);
+      std::iota(input.begin(), input.end(), std::uint64_t{});
+      auto sum = std::uint64_t{};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        for(auto block : from(input) | chunk(16))
+          {
+          sum += std::accumulate(block.begin(), block.end(), std::uint64_t{});
+          }
+        clobber(sum);
+        }
+      return std::size_t{};
+    });
+
+    registry.add("generator/drain", {{"implementation", "sophia::flow"}, {"elements", "1024"}}, [](std::size_t iterations){
+      auto sink = std::string{};
+      auto bytes = std::size_t{};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        sink.clear();
+        drain(iota(0) | take(elements), sink);
+        bytes += sink.size();
+        keep(sink);
+        }
+      return bytes;
+    });
+
+    registry.add("generator/format", {{"implementation", "sophia::string"}, {"elements", "1024"}}, [](std::size_t iterations){
+      auto sink = std::string{};
+      auto bytes = std::size_t{};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        sink.clear();
+        for(auto n = 0; n < static_cast<int>(elements); ++n)
+          {
+          sophia::string::format_to(sink, "{0}\n", n);
+          }
+        bytes += sink.size();
+        keep(sink);
+        }
+      return bytes;
+    });
+    }
+
+  }
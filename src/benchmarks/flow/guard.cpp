@@ -0,0 +1,67 @@
+#include "bench.hpp"
+
+#include "sophia/flow/guard.hpp"
+
+#include <cassert>
+#include <cstdlib>
+
+namespace bench
+  {
+
+  void register_guard(registry & registry)
+    {
+    registry.add("guard/sophia", {{"implementation", "sophia::flow::guard"}}, [](std::size_t iterations){
+      auto condition = true;
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        clobber(condition);
+        sophia::flow::guard(condition);
+        }
+      return std::size_t{};
+    });
+
+    registry.add("guard/sophia+message", {{"implementation", "sophia::flow::guard"}}, [](std::size_t iterations){
+      auto condition = true;
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        clobber(condition);
+        sophia::flow::guard(condition, "the condition must hold");
+        }
+      return std::size_t{};
+    });
+
+    registry.add("guard/sophia+handler", {{"implementation", "sophia::flow::guard"}}, [](std::size_t iterations){
+      auto condition = true;
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        clobber(condition);
+        sophia::flow::guard(condition, "the condition must hold") || []{ std::abort(); };
+        }
+      return std::size_t{};
+    });
+
+    registry.add("guard/if", {{"implementation", "if"}}, [](std::size_t iterations){
+      auto condition = true;
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        clobber(condition);
+        if(!condition)
+          {
+          std::abort();
+          }
+        }
+      return std::size_t{};
+    });
+
+    registry.add("guard/assert", {{"implementation", "assert"}}, [](std::size_t iterations){
+      auto condition = true;
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        clobber(condition);
+        assert(condition && "the condition must hold");
+        }
+      return std::size_t{};
+    });
+    }
+
+  }
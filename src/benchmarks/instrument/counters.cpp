@@ -0,0 +1,23 @@
+#include "bench.hpp"
+
+#include "sophia/instrument/counters.hpp"
+
+namespace bench
+  {
+
+  void register_instrument(registry & registry)
+    {
+    auto const enabled = sophia::instrument::enabled ? "true" : "false";
+
+    registry.add("instrument/scope", {{"enabled", enabled}}, [](std::size_t iterations){
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        auto probe = sophia::instrument::scope{sophia::instrument::probe::format};
+        probe.produced(iteration);
+        probe.allocated(0);
+        }
+      return std::size_t{};
+    });
+    }
+
+  }
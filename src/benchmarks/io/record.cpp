@@ -0,0 +1,195 @@
+#include "bench.hpp"
+
+#include "sophia/io/record.hpp"
+#include "sophia/string/format.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+  {
+
+  struct log_entry
+    {
+    std::uint64_t timestamp;
+    char const * level;
+    std::string message;
+    std::string request;
+    int status;
+    double latency;
+    std::uint64_t bytes;
+    bool cached;
+    std::string agent;
+    };
+
+  std::vector<log_entry> make_entries()
+    {
+    auto random = std::mt19937_64{42};
+    auto entries = std::vector<log_entry>{};
+    auto const agent = std::string{"Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) "
+                                   "Chrome/120.0.0.0 Safari/537.36"};
+
+    for(auto index = 0u; index < 1024u; ++index)
+      {
+      auto message = "GET /api/v1/users/" + std::to_string(random() % 100000) + " completed";
+      if(index % 16 == 0)
+        {
+        message += " with warning \"slow upstream\"\n\tretrying";
+        }
+
+      auto request = std::string{};
+      for(auto digit = 0; digit < 32; ++digit)
+        {
+        request += "0123456789abcdef"[random() % 16];
+        }
+
+      entries.push_back({1700000000000ull + index,
+                         index % 8 ? "info" : "warn",
+                         std::move(message),
+                         std::move(request),
+                         index % 10 ? 200 : 503,
+                         (random() % 100000) / 1000.0,
+                         random() % 65536,
+                         index % 3 == 0,
+                         agent});
+      }
+
+    return entries;
+    }
+
+  std::string escape_by_hand(std::string const & text)
+    {
+    auto escaped = std::string{};
+    for(auto character : text)
+      {
+      switch(character)
+        {
+        case '"': escaped += "\\\""; break;
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n"; break;
+        case '\t': escaped += "\\t"; break;
+        case '\r': escaped += "\\r"; break;
+        default: escaped += character;
+        }
+      }
+    return escaped;
+    }
+
+  void add_record_cases(bench::registry & registry)
+    {
+    using sophia::io::field;
+    using sophia::io::record_format;
+
+    auto const entries = std::make_shared<std::vector<log_entry>>(make_entries());
+
+    for(auto [name, format] : {std::pair{"json", record_format::json}, std::pair{"logfmt", record_format::logfmt}})
+      {
+      registry.add(std::string{"record/"} + name + "/write_record", {{"implementation", "write_record"}, {"format", name}},
+                   [=, format = format](std::size_t iterations){
+        auto buffer = std::string{};
+        auto bytes = std::size_t{};
+        for(auto iteration = 0ull; iteration < iterations; ++iteration)
+          {
+          if(iteration % entries->size() == 0)
+            {
+            bytes += buffer.size();
+            buffer.clear();
+            }
+
+          auto const & entry = (*entries)[iteration % entries->size()];
+          sophia::io::write_record(buffer,
+                                   format,
+                                   field{"ts", entry.timestamp},
+                                   field{"level", entry.level},
+                                   field{"msg", entry.message},
+                                   field{"request_id", entry.request},
+                                   field{"status", entry.status},
+                                   field{"latency_ms", entry.latency},
+                                   field{"bytes", entry.bytes},
+                                   field{"cached", entry.cached},
+                                   field{"user_agent", entry.agent});
+          }
+        bench::keep(buffer);
+        return bytes + buffer.size();
+      });
+      }
+
+    registry.add("record/json/escape_and_format", {{"implementation", "escape_and_format"}, {"format", "json"}},
+                 [=](std::size_t iterations){
+      auto buffer = std::string{};
+      auto bytes = std::size_t{};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        if(iteration % entries->size() == 0)
+          {
+          bytes += buffer.size();
+          buffer.clear();
+          }
+
+        auto const & entry = (*entries)[iteration % entries->size()];
+        buffer += sophia::string::format(
+          "{\"ts\":{0},\"level\":\"{1}\",\"msg\":\"{2}\",\"request_id\":\"{3}\",\"status\":{4},\"latency_ms\":{5},"
+          "\"bytes\":{6},\"cached\":{7},\"user_agent\":\"{8}\"}\n",
+          entry.timestamp,
+          entry.level,
+          escape_by_hand(entry.message),
+          escape_by_hand(entry.request),
+          entry.status,
+          entry.latency,
+          entry.bytes,
+          entry.cached ? "true" : "false",
+          escape_by_hand(entry.agent));
+        }
+      bench::keep(buffer);
+      return bytes + buffer.size();
+    });
+    }
+
+  void add_escape_cases(bench::registry & registry)
+    {
+    for(auto density : {0u, 1u, 10u})
+      {
+      auto const text = std::make_shared<std::string>();
+      auto random = std::mt19937{density};
+      for(auto index = 0u; index < 4096u; ++index)
+        {
+        *text += random() % 100 < density ? '"' : static_cast<char>('a' + random() % 26);
+        }
+
+      auto const suffix = "/escapes:" + std::to_string(density) + "%";
+      auto const add = [&](std::string const & implementation, void (* escape)(std::string &, std::string_view)){
+        registry.add("escape/" + implementation + suffix,
+                     {{"implementation", implementation}, {"length", "4096"}, {"escape_percent", std::to_string(density)}},
+                     [=](std::size_t iterations){
+          auto output = std::string{};
+          for(auto iteration = 0ull; iteration < iterations; ++iteration)
+            {
+            output.clear();
+            escape(output, *text);
+            bench::keep(output);
+            }
+          return iterations * text->size();
+        });
+      };
+
+      add("vectorized", &sophia::io::internal::escape);
+      add("scalar", &sophia::io::internal::escape_scalar);
+      }
+    }
+
+  }
+
+namespace bench
+  {
+
+  void register_record(registry & registry)
+    {
+    add_record_cases(registry);
+    add_escape_cases(registry);
+    }
+
+  }
@@ -0,0 +1,120 @@
+#include "bench.hpp"
+
+#include "sophia/io/printf.hpp"
+#include "sophia/io/write.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+  {
+
+  using parameters = std::vector<std::pair<std::string, std::string>>;
+
+  struct file_closer
+    {
+    void operator()(std::FILE * file) const
+      {
+      std::fclose(file);
+      }
+    };
+
+  /**
+   * @brief The total number of decimal digits needed to print the numbers 0 to @p count - 1
+   *
+   * Every number has at least one digit, and each number that is at least 10^k has one more.
+   */
+  std::size_t digits_below(std::size_t count)
+    {
+    auto total = count;
+    for(auto power = std::size_t{10}; power < count; power *= 10)
+      {
+      total += count - power;
+      }
+    return total;
+    }
+
+  parameters describe(std::string const & implementation, std::size_t length)
+    {
+    return {{"implementation", implementation}, {"length", std::to_string(length)}};
+    }
+
+  void add_cases(bench::registry & registry, std::size_t length)
+    {
+    auto const text = std::make_shared<std::string>(length, 'x');
+    auto const suffix = ":" + std::to_string(length);
+
+    registry.add("write/sophia" + suffix, describe("sophia::io::write", length), [=](std::size_t iterations){
+      auto stream = std::ofstream{"/dev/null"};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        sophia::io::write(stream, *text);
+        }
+      return iterations * text->size();
+    });
+
+    registry.add("write/fwrite" + suffix, describe("fwrite", length), [=](std::size_t iterations){
+      auto file = std::unique_ptr<std::FILE, file_closer>{std::fopen("/dev/null", "w")};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        std::fwrite(text->data(), 1, text->size(), file.get());
+        }
+      return iterations * text->size();
+    });
+
+    registry.add("writeln/sophia" + suffix, describe("sophia::io::writeln", length), [=](std::size_t iterations){
+      auto stream = std::ofstream{"/dev/null"};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        sophia::io::writeln(stream, *text);
+        }
+      return iterations * (text->size() + 1);
+    });
+
+    registry.add("writeln/fwrite" + suffix, describe("fwrite", length), [=](std::size_t iterations){
+      auto file = std::unique_ptr<std::FILE, file_closer>{std::fopen("/dev/null", "w")};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        std::fwrite(text->data(), 1, text->size(), file.get());
+        std::fputc('\n', file.get());
+        }
+      return iterations * (text->size() + 1);
+    });
+
+    registry.add("printf/sophia" + suffix, describe("sophia::io::printf", length), [=](std::size_t iterations){
+      auto stream = std::ofstream{"/dev/null"};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        sophia::io::printf(stream, "{0} {1}\n", iteration, *text);
+        }
+      return iterations * (text->size() + 2) + digits_below(iterations);
+    });
+
+    registry.add("printf/fprintf" + suffix, describe("fprintf", length), [=](std::size_t iterations){
+      auto file = std::unique_ptr<std::FILE, file_closer>{std::fopen("/dev/null", "w")};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        std::fprintf(file.get(), "%zu %s\n", static_cast<std::size_t>(iteration), text->c_str());
+        }
+      return iterations * (text->size() + 2) + digits_below(iterations);
+    });
+    }
+
+  }
+
+namespace bench
+  {
+
+  void register_write(registry & registry)
+    {
+    for(auto length : {8u, 64u, 512u, 4096u})
+      {
+      add_cases(registry, length);
+      }
+    }
+
+  }
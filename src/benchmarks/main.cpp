@@ -0,0 +1,184 @@
+#include "bench.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#ifndef SOPHIA_VERSION
+#define SOPHIA_VERSION "unknown"
+#endif
+
+#ifndef SOPHIA_BUILD_TYPE
+#define SOPHIA_BUILD_TYPE "unknown"
+#endif
+
+namespace
+  {
+
+  struct options
+    {
+    std::string filter{};
+    std::string output{};
+    double min_time{0.05};
+    std::size_t repetitions{5};
+    bool list{};
+    };
+
+  std::string quote(std::string const & text)
+    {
+    auto quoted = std::string{"\""};
+    for(auto character : text)
+      {
+      switch(character)
+        {
+        case '"': quoted += "\\\""; break;
+        case '\\': quoted += "\\\\"; break;
+        case '\n': quoted += "\\n"; break;
+        case '\r': quoted += "\\r"; break;
+        case '\t': quoted += "\\t"; break;
+        default:
+          if(static_cast<unsigned char>(character) < 0x20)
+            {
+            char escaped[7];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(character));
+            quoted += escaped;
+            }
+          else
+            {
+            quoted += character;
+            }
+        }
+      }
+    return quoted + '"';
+    }
+
+  void report(std::ostream & stream, std::vector<bench::result> const & results)
+    {
+    stream << "{\n";
+    stream << "  \"library\": \"sophia\",\n";
+    stream << "  \"version\": " << quote(SOPHIA_VERSION) << ",\n";
+    stream << "  \"build_type\": " << quote(SOPHIA_BUILD_TYPE) << ",\n";
+    stream << "  \"compiler\": " << quote(__VERSION__) << ",\n";
+    stream << "  \"benchmarks\": [";
+
+    auto separator = "\n";
+    for(auto const & result : results)
+      {
+      auto const & times = result.nanoseconds_per_operation;
+      stream << separator << "    {\n";
+      stream << "      \"name\": " << quote(result.source->name) << ",\n";
+      stream << "      \"parameters\": {";
+
+      auto parameter_separator = "";
+      for(auto const & [key, value] : result.source->parameters)
+        {
+        stream << parameter_separator << quote(key) << ": " << quote(value);
+        parameter_separator = ", ";
+        }
+
+      stream << "},\n";
+      stream << "      \"iterations\": " << result.iterations << ",\n";
+      stream << "      \"repetitions\": " << times.size() << ",\n";
+      stream << "      \"ns_per_op\": {";
+      stream << "\"min\": " << times.front() << ", ";
+      stream << "\"median\": " << times[times.size() / 2] << ", ";
+      stream << "\"max\": " << times.back() << "},\n";
+      stream << "      \"bytes_per_op\": " << result.bytes_per_operation << "\n";
+      stream << "    }";
+      separator = ",\n";
+      }
+
+    stream << "\n  ]\n}\n";
+    }
+
+  options parse(int argc, char * * argv)
+    {
+    auto parsed = options{};
+    for(auto index = 1; index < argc; ++index)
+      {
+      auto const argument = std::string{argv[index]};
+      auto const value = argument.substr(argument.find('=') + 1);
+
+      if(argument.rfind("--filter=", 0) == 0)
+        {
+        parsed.filter = value;
+        }
+      else if(argument.rfind("--output=", 0) == 0)
+        {
+        parsed.output = value;
+        }
+      else if(argument.rfind("--min-time=", 0) == 0)
+        {
+        parsed.min_time = std::strtod(value.c_str(), nullptr);
+        }
+      else if(argument.rfind("--repetitions=", 0) == 0)
+        {
+        parsed.repetitions = std::max(1ull, std::strtoull(value.c_str(), nullptr, 10));
+        }
+      else if(argument == "--list")
+        {
+        parsed.list = true;
+        }
+      else
+        {
+        std::cerr << "usage: " << argv[0]
+                  << " [--filter=SUBSTRING] [--output=FILE] [--min-time=SECONDS] [--repetitions=COUNT] [--list]\n";
+        std::exit(argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+      }
+    return parsed;
+    }
+
+  }
+
+int main(int argc, char * * argv)
+  {
+  auto const options = parse(argc, argv);
+
+  auto registry = bench::registry{};
+  bench::register_format(registry);
+  bench::register_write(registry);
+  bench::register_flat_hash_map(registry);
+  bench::register_small_vector(registry);
+  bench::register_executor(registry);
+  bench::register_generator(registry);
+  bench::register_guard(registry);
+  bench::register_instrument(registry);
+  bench::register_record(registry);
+
+  auto results = std::vector<bench::result>{};
+  for(auto const & benchmark : registry.benchmarks())
+    {
+    if(benchmark.name.find(options.filter) == std::string::npos)
+      {
+      continue;
+      }
+
+    if(options.list)
+      {
+      std::cout << benchmark.name << '\n';
+      continue;
+      }
+
+    std::cerr << benchmark.name << "... " << std::flush;
+    results.push_back(bench::measure(benchmark, options.min_time, options.repetitions));
+    std::cerr << results.back().nanoseconds_per_operation[options.repetitions / 2] << " ns/op\n";
+    }
+
+  if(options.list)
+    {
+    return EXIT_SUCCESS;
+    }
+
+  if(options.output.empty())
+    {
+    report(std::cout, results);
+    }
+  else
+    {
+    auto file = std::ofstream{options.output};
+    report(file, results);
+    }
+  }
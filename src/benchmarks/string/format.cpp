@@ -0,0 +1,200 @@
+#include "bench.hpp"
+
+#include "sophia/string/format.hpp"
+#include "sophia/string/format_batch.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+  {
+
+  using parameters = std::vector<std::pair<std::string, std::string>>;
+
+  template<std::size_t, typename ValueType>
+  using repeat = ValueType;
+
+  char const * c_argument(std::string const & value) { return value.c_str(); }
+  int c_argument(int value) { return value; }
+  double c_argument(double value) { return value; }
+
+  char const * c_specifier(std::string const &) { return "%s"; }
+  char const * c_specifier(int) { return "%d"; }
+  char const * c_specifier(double) { return "%g"; }
+
+  char * append_chars(char * first, char * last, int value) { return std::to_chars(first, last, value).ptr; }
+  char * append_chars(char * first, char * last, double value) { return std::to_chars(first, last, value).ptr; }
+
+  template<typename ValueType, std::size_t ...Indices>
+  void add_cases(bench::registry & registry,
+                 std::string const & type,
+                 std::size_t length,
+                 ValueType const & value,
+                 std::index_sequence<Indices...>)
+    {
+    constexpr auto count = sizeof...(Indices);
+
+    auto sophia_format = std::string{};
+    auto c_format = std::string{};
+    for(auto index = 0ull; index < count; ++index)
+      {
+      sophia_format += '{' + std::to_string(index) + "} ";
+      c_format += c_specifier(value) + std::string{" "};
+      }
+
+    auto const arguments = std::make_shared<std::tuple<repeat<Indices, ValueType>...>>((static_cast<void>(Indices), value)...);
+
+    auto const name = [&](std::string const & implementation){
+      return "format/" + implementation + '/' + type + (length ? ':' + std::to_string(length) : "") +
+        "/args:" + std::to_string(count);
+    };
+
+    auto const describe = [&](std::string const & implementation){
+      return parameters{{"implementation", implementation},
+                        {"type", type},
+                        {"length", std::to_string(length)},
+                        {"arguments", std::to_string(count)}};
+    };
+
+    registry.add(name("sophia"), describe("sophia"), [=](std::size_t iterations){
+      auto bytes = std::size_t{};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        auto const result = std::apply([&](auto const & ...values){
+          return sophia::string::format(sophia_format, values...);
+        }, *arguments);
+        bench::keep(result);
+        bytes += result.size();
+        }
+      return bytes;
+    });
+
+    registry.add(name("snprintf"), describe("snprintf"), [=](std::size_t iterations){
+      auto bytes = std::size_t{};
+      char buffer[8192];
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        auto const written = std::apply([&](auto const & ...values){
+          return std::snprintf(buffer, sizeof(buffer), c_format.c_str(), c_argument(values)...);
+        }, *arguments);
+        bench::keep(buffer);
+        bytes += static_cast<std::size_t>(written);
+        }
+      return bytes;
+    });
+
+    registry.add(name("ostringstream"), describe("ostringstream"), [=](std::size_t iterations){
+      auto bytes = std::size_t{};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        auto stream = std::ostringstream{};
+        std::apply([&](auto const & ...values){ ((stream << values << ' '), ...); }, *arguments);
+        auto const result = stream.str();
+        bench::keep(result);
+        bytes += result.size();
+        }
+      return bytes;
+    });
+
+    if constexpr(!std::is_same<ValueType, std::string>::value)
+      {
+      registry.add(name("to_chars"), describe("to_chars"), [=](std::size_t iterations){
+        auto bytes = std::size_t{};
+        char buffer[8192];
+        for(auto iteration = 0ull; iteration < iterations; ++iteration)
+          {
+          auto last = buffer;
+          std::apply([&](auto const & ...values){
+            ((last = append_chars(last, buffer + sizeof(buffer) - 1, values), *last++ = ' '), ...);
+          }, *arguments);
+          bench::keep(buffer);
+          bytes += static_cast<std::size_t>(last - buffer);
+          }
+        return bytes;
+      });
+      }
+    }
+
+  template<typename ValueType>
+  void add_sweep(bench::registry & registry, std::string const & type, std::size_t length, ValueType const & value)
+    {
+    add_cases(registry, type, length, value, std::make_index_sequence<1>{});
+    add_cases(registry, type, length, value, std::make_index_sequence<2>{});
+    add_cases(registry, type, length, value, std::make_index_sequence<4>{});
+    add_cases(registry, type, length, value, std::make_index_sequence<8>{});
+    }
+
+  void add_batch_cases(bench::registry & registry)
+    {
+    using record = std::tuple<unsigned, std::string, double>;
+
+    auto const records = std::make_shared<std::vector<record>>();
+    for(auto id = 0u; id < 100'000u; ++id)
+      {
+      records->emplace_back(id, "record-" + std::to_string(id % 1000), id * 0.25);
+      }
+
+    auto const format = std::string{"id={0} name={1} value={2}\n"};
+
+    registry.add("format_batch/serial", {{"implementation", "serial"}, {"records", "100000"}}, [=](std::size_t iterations){
+      auto bytes = std::size_t{};
+      for(auto iteration = 0ull; iteration < iterations; ++iteration)
+        {
+        auto output = std::string{};
+        for(auto const & [id, name, value] : *records)
+          {
+          sophia::string::format_to(output, format, id, name, value);
+          }
+        bench::keep(output);
+        bytes += output.size();
+        }
+      return bytes;
+    });
+
+    auto const hardware = std::max(1u, std::thread::hardware_concurrency());
+    for(auto workers = 1u; workers <= hardware; workers *= 2)
+      {
+      auto const name = "format_batch/workers:" + std::to_string(workers);
+      auto const description = parameters{{"implementation", "format_batch"},
+                                           {"records", "100000"},
+                                           {"workers", std::to_string(workers)}};
+
+      registry.add(name, description, [=](std::size_t iterations){
+        auto bytes = std::size_t{};
+        for(auto iteration = 0ull; iteration < iterations; ++iteration)
+          {
+          auto const output = sophia::string::format_batch(format, *records, workers);
+          bench::keep(output);
+          bytes += output.size();
+          }
+        return bytes;
+      });
+      }
+    }
+
+  }
+
+namespace bench
+  {
+
+  void register_format(registry & registry)
+    {
+    add_sweep(registry, "int", 0, 1234567);
+    add_sweep(registry, "double", 0, 3.14159);
+    for(auto length : {8u, 64u, 512u})
+      {
+      add_sweep(registry, "string", length, std::string(length, 'x'));
+      }
+    add_batch_cases(registry);
+    }
+
+  }
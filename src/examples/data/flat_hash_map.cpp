@@ -0,0 +1,29 @@
+#include "sophia/data/flat_hash_map.hpp"
+#include "sophia/data/flat_hash_set.hpp"
+#include "sophia/io/printf.hpp"
+
+#include <string>
+#include <string_view>
+
+int main()
+  {
+  using namespace sophia;
+
+  auto counts = data::flat_hash_map<std::string, int>{};
+  auto const text = std::string_view{"the quick brown fox jumps over the lazy dog the end"};
+
+  for(auto first = std::size_t{}; first < text.size();)
+    {
+    auto const last = std::min(text.find(' ', first), text.size());
+    ++counts[std::string{text.substr(first, last - first)}];
+    first = last + 1;
+    }
+
+  io::printf("'the' occurs {0} times\n", counts.at(std::string_view{"the"}));
+  io::printf("'cat' occurs {0} times\n", counts.contains("cat") ? counts.at("cat") : 0);
+  io::printf("{0} distinct words, load factor {1}\n", counts.size(), counts.load_factor());
+
+  auto primes = data::flat_hash_set<int>{2, 3, 5, 7, 11, 13};
+  primes.erase(2);
+  io::printf("7 is {0}prime, 9 is {1}prime\n", primes.contains(7) ? "" : "not ", primes.contains(9) ? "" : "not ");
+  }
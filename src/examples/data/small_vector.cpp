@@ -0,0 +1,61 @@
+#include "sophia/data/small_vector.hpp"
+#include "sophia/io/printf.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace
+  {
+
+  std::size_t allocations{};
+
+  template<typename ValueType>
+  struct counting_allocator : std::allocator<ValueType>
+    {
+    using value_type = ValueType;
+
+    template<typename OtherType>
+    struct rebind
+      {
+      using other = counting_allocator<OtherType>;
+      };
+
+    counting_allocator() = default;
+
+    template<typename OtherType>
+    counting_allocator(counting_allocator<OtherType> const &) noexcept
+      {
+
+      }
+
+    ValueType * allocate(std::size_t count)
+      {
+      ++allocations;
+      return std::allocator<ValueType>::allocate(count);
+      }
+    };
+
+  }
+
+int main()
+  {
+  using namespace sophia;
+
+  auto tokens = data::small_vector<std::string_view, 8, counting_allocator<std::string_view>>{};
+  auto const text = std::string_view{"the quick brown fox jumps over the lazy dog"};
+
+  for(auto first = std::size_t{}; first < text.size();)
+    {
+    auto const last = std::min(text.find(' ', first), text.size());
+    tokens.push_back(text.substr(first, last - first));
+    io::printf("{0} tokens, {1}, {2} allocations\n", tokens.size(), tokens.is_inline() ? "inline" : "on the heap", allocations);
+    first = last + 1;
+    }
+
+  tokens.erase(tokens.begin() + 1, tokens.begin() + 4);
+  tokens.shrink_to_fit();
+  io::printf("after erasing: {0} tokens, {1}, {2} allocations\n", tokens.size(), tokens.is_inline() ? "inline" : "on the heap", allocations);
+  }
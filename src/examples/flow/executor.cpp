@@ -0,0 +1,67 @@
+#include "sophia/flow/executor.hpp"
+#include "sophia/io/printf.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+long fibonacci(sophia::flow::executor & executor, long n)
+  {
+  if(n < 16)
+    {
+    return n < 2 ? n : fibonacci(executor, n - 1) + fibonacci(executor, n - 2);
+    }
+
+  auto group = sophia::flow::task_group{executor};
+  auto first = 0l;
+  group.run([&]{ first = fibonacci(executor, n - 1); });
+  auto const second = fibonacci(executor, n - 2);
+  group.wait();
+  return first + second;
+  }
+
+int main(int argc, char * * argv)
+  {
+  using namespace sophia;
+
+  auto const rounds = argc > 1 ? std::atoi(argv[1]) : 1;
+  auto const workers = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0ul;
+  auto executor = flow::executor{workers};
+  io::printf("running {0} round(s) on {1} worker(s)\n", rounds, executor.concurrency());
+
+  for(auto round = 0; round < rounds; ++round)
+    {
+    auto values = std::vector<long>(1 << 20);
+    flow::parallel_for(executor, 0ul, values.size(), [&](auto index){ values[index] = static_cast<long>(index); });
+    auto const sum = std::accumulate(values.begin(), values.end(), 0l);
+    auto const expected = static_cast<long>(values.size() * (values.size() - 1) / 2);
+
+    auto counter = std::atomic<long>{};
+    flow::parallel_for(executor, 0, 100000, [&](int){ counter.fetch_add(1, std::memory_order_relaxed); }, 1);
+
+    auto const fib = fibonacci(executor, 30);
+
+    auto caught = false;
+    try
+      {
+      auto group = flow::task_group{executor};
+      group.run([]{ throw std::runtime_error{"task failed"}; });
+      group.run([]{ });
+      group.wait();
+      }
+    catch(std::runtime_error const &)
+      {
+      caught = true;
+      }
+
+    if(sum != expected || counter != 100000 || fib != 832040 || !caught)
+      {
+      io::printf("round {0} produced wrong results\n", round);
+      return EXIT_FAILURE;
+      }
+    }
+
+  io::printf("sum, count, fibonacci(30) and exception propagation are correct\n");
+  }
@@ -0,0 +1,30 @@
+#include "sophia/flow/generator.hpp"
+
+#include <iostream>
+#include <optional>
+#include <vector>
+
+int main()
+  {
+  using namespace sophia::flow;
+
+  auto odd_squares = iota(1) | map([](int n){ return n * n; }) | filter([](int n){ return n % 2; }) | take(5);
+  drain(odd_squares, std::cout, " ");
+  std::cout << '\n';
+
+  auto words = std::vector<char const *>{"lazy", "pipelines", "pull", "one", "element", "at", "a", "time"};
+  drain(from(words) | chunk(3), std::cout);
+
+  auto fibonacci = generate([a = 0ull, b = 1ull]() mutable -> std::optional<unsigned long long> {
+    auto next = a;
+    a = b;
+    b += next;
+    return next;
+  });
+
+  for(auto number : std::move(fibonacci) | take(10))
+    {
+    std::cout << number << ' ';
+    }
+  std::cout << '\n';
+  }
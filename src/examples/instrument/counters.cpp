@@ -0,0 +1,46 @@
+#ifndef SOPHIA_ENABLE_INSTRUMENTATION
+#define SOPHIA_ENABLE_INSTRUMENTATION
+#endif
+
+#include "sophia/instrument/instrument.hpp"
+#include "sophia/io/printf.hpp"
+#include "sophia/string/format.hpp"
+
+#include <sstream>
+#include <thread>
+
+int main()
+  {
+  using namespace sophia;
+
+  auto worker = std::thread{[]{
+    for(auto index = 0; index < 1000; ++index)
+      {
+      string::format("{0} is formatted on a worker thread", index);
+      }
+  }};
+
+  auto sink = std::ostringstream{};
+  for(auto index = 0; index < 1000; ++index)
+    {
+    io::printf(sink, "{0} is printed on the main thread\n", index);
+    }
+
+  worker.join();
+
+  auto const counters = instrument::collect();
+  for(auto [name, which] : {std::pair{"format", instrument::probe::format},
+                            std::pair{"printf", instrument::probe::printf},
+                            std::pair{"record", instrument::probe::record}})
+    {
+    auto const & statistics = counters[which];
+    io::printf("{0}: {1} calls, {2} bytes, {3} allocations, p50 < {4} {6}, p99 < {5} {6}\n",
+               name,
+               statistics.calls,
+               statistics.bytes,
+               statistics.allocations,
+               statistics.percentile(0.5),
+               statistics.percentile(0.99),
+               instrument::tick_unit);
+    }
+  }
@@ -0,0 +1,11 @@
+#include "sophia/io/record.hpp"
+
+#include <iostream>
+
+int main()
+  {
+  using namespace sophia::io;
+
+  write_record(std::cout, record_format::json, field{"level", "info"}, field{"msg", "said \"hello\""}, field{"status", 200});
+  write_record(std::cout, record_format::logfmt, field{"level", "info"}, field{"msg", "said \"hello\""}, field{"status", 200});
+  }
@@ -0,0 +1,16 @@
+#include "sophia/string/format_batch.hpp"
+
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+int main()
+  {
+  auto records = std::vector<std::tuple<int, char const *, double>>{};
+  for(auto id = 0; id < 10; ++id)
+    {
+    records.emplace_back(id, id % 2 ? "odd" : "even", id * 1.5);
+    }
+
+  sophia::string::format_batch(std::cout, "{0}: {1} ({2})\n", records);
+  }
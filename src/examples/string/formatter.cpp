@@ -0,0 +1,34 @@
+#include "sophia/io/printf.hpp"
+
+#include <cstddef>
+
+struct point
+  {
+  int x;
+  int y;
+  };
+
+template<>
+struct sophia::formatter<point>
+  {
+  static std::size_t max_size(point const &)
+    {
+    return 2 * formatter<int>::max_size(0) + 4;
+    }
+
+  static char * format(point const & value, char * out)
+    {
+    *out++ = '(';
+    out = formatter<int>::format(value.x, out);
+    *out++ = ',';
+    *out++ = ' ';
+    out = formatter<int>::format(value.y, out);
+    *out++ = ')';
+    return out;
+    }
+  };
+
+int main()
+  {
+  sophia::io::printf("{0} is a point, {1} is a number\n", point{4, 2}, 42);
+  }
@@ -0,0 +1,17 @@
+#include "sophia/io/printf.hpp"
+#include "sophia/string/static_format.hpp"
+
+#include <climits>
+
+enum severity { debug, info, warning };
+
+constexpr auto version = sophia::string::static_format<16>("v{0}.{1}.{2}", 0, 3, 0);
+constexpr auto banner = sophia::string::static_format("sophia {0} [{1}|{2}] {3}{4}", version, "info", info, 'x', LLONG_MIN);
+
+static_assert(version == "v0.3.0");
+static_assert(banner == "sophia v0.3.0 [info|1] x-9223372036854775808");
+
+int main()
+  {
+  sophia::io::printf("{0}\n{1}\n", version, banner);
+  }
@@ -0,0 +1,159 @@
+# Compare the code size and compile time of sophia::string::format against the fully templated implementation it replaced.
+#
+# This script generates a synthetic program with CALL_SITES calls to format, each using a distinct combination of argument
+# types, builds it once against each implementation, and reports the results.
+#
+# Expected variables: COMPILER, FLAGS, SOURCE_DIR, INCLUDE_DIR, OUTPUT_DIR, CALL_SITES and optionally SIZE_TOOL
+#
+# The script only uses commands available in CMake 3.2, the minimum version required by the project.
+
+# Store the current time in microseconds in the given variable. string(TIMESTAMP) supports neither seconds since the
+# epoch before CMake 3.6 nor sub-second resolution before CMake 3.23, so the time is taken from date(1) instead. If date(1)
+# does not support nanoseconds, the time is measured in whole seconds.
+function(current_time OUTPUT)
+  execute_process(COMMAND date "+%s%N" OUTPUT_VARIABLE NOW OUTPUT_STRIP_TRAILING_WHITESPACE ERROR_QUIET)
+  if(NOW MATCHES "^[0-9]+$")
+    math(EXPR NOW "${NOW} / 1000")
+  else()
+    execute_process(COMMAND date "+%s" OUTPUT_VARIABLE NOW OUTPUT_STRIP_TRAILING_WHITESPACE ERROR_QUIET)
+    if(NOT NOW MATCHES "^[0-9]+$")
+      message(FATAL_ERROR "Failed to read the current time using date(1)")
+    endif()
+    math(EXPR NOW "${NOW} * 1000000")
+  endif()
+  set(${OUTPUT} ${NOW} PARENT_SCOPE)
+endfunction()
+
+set(TYPES "int;unsigned;long;unsigned long;short;char;double;float;std::string;char const *")
+set(MEMBERS "i;u;l;ul;s;c;d;f;str;cs")
+set(INITIALIZERS "argc;2u;3l;4ul;5;'c';6.5;7.5f;\"eight\";\"nine\"")
+list(LENGTH TYPES TYPE_COUNT)
+
+# Build the function definitions and calls, enumerating type combinations of arity 1, 2 and 3
+set(SITES "")
+set(CALLS "")
+set(SITE 0)
+foreach(ARITY 1 2 3)
+  math(EXPR COMBINATIONS "${TYPE_COUNT}")
+  if(ARITY GREATER 1)
+    math(EXPR COMBINATIONS "${COMBINATIONS} * ${TYPE_COUNT}")
+  endif()
+  if(ARITY GREATER 2)
+    math(EXPR COMBINATIONS "${COMBINATIONS} * ${TYPE_COUNT}")
+  endif()
+  math(EXPR LAST "${COMBINATIONS} - 1")
+
+  foreach(COMBINATION RANGE ${LAST})
+    if(NOT SITE LESS CALL_SITES)
+      break()
+    endif()
+
+    set(FORMAT "site ${SITE}:")
+    set(ARGUMENTS "")
+    set(REST ${COMBINATION})
+    math(EXPR LAST_ARGUMENT "${ARITY} - 1")
+    foreach(ARGUMENT RANGE ${LAST_ARGUMENT})
+      math(EXPR TYPE "${REST} % ${TYPE_COUNT}")
+      math(EXPR REST "${REST} / ${TYPE_COUNT}")
+      list(GET MEMBERS ${TYPE} MEMBER)
+      set(FORMAT "${FORMAT} {${ARGUMENT}}")
+      set(ARGUMENTS "${ARGUMENTS}, v.${MEMBER}")
+    endforeach()
+
+    set(SITES "${SITES}std::size_t site_${SITE}(values const & v) { return NAMESPACE::format(\"${FORMAT}\\n\"${ARGUMENTS}).size(); }\n")
+    set(CALLS "${CALLS}  total += site_${SITE}(v);\n")
+    math(EXPR SITE "${SITE} + 1")
+  endforeach()
+endforeach()
+
+set(MEMBER_DECLARATIONS "")
+set(MEMBER_INITIALIZERS "")
+math(EXPR LAST_TYPE "${TYPE_COUNT} - 1")
+foreach(TYPE RANGE ${LAST_TYPE})
+  list(GET TYPES ${TYPE} TYPE_NAME)
+  list(GET MEMBERS ${TYPE} MEMBER)
+  list(GET INITIALIZERS ${TYPE} INITIALIZER)
+  set(MEMBER_DECLARATIONS "${MEMBER_DECLARATIONS}  ${TYPE_NAME} ${MEMBER};\n")
+  set(MEMBER_INITIALIZERS "${MEMBER_INITIALIZERS}    ${INITIALIZER},\n")
+endforeach()
+
+set(REPORT "")
+foreach(VARIANT "erased" "templated")
+  if(VARIANT STREQUAL "erased")
+    set(HEADER "sophia/string/format.hpp")
+    set(NAMESPACE "sophia::string")
+  else()
+    set(HEADER "legacy_format.hpp")
+    set(NAMESPACE "legacy")
+  endif()
+
+  string(REPLACE "NAMESPACE" "${NAMESPACE}" VARIANT_SITES "${SITES}")
+  set(SOURCE "${OUTPUT_DIR}/size_${VARIANT}.cpp")
+  set(BINARY "${OUTPUT_DIR}/size_${VARIANT}")
+
+  file(WRITE "${SOURCE}"
+    "#include \"${HEADER}\"\n\n"
+    "#include <cstddef>\n#include <string>\n\n"
+    "struct values\n  {\n${MEMBER_DECLARATIONS}  };\n\n"
+    "${VARIANT_SITES}\n"
+    "int main(int argc, char * *)\n  {\n  auto const v = values{\n${MEMBER_INITIALIZERS}    };\n\n"
+    "  auto total = std::size_t{};\n${CALLS}  return static_cast<int>(total & 1);\n  }\n"
+    )
+
+  separate_arguments(COMPILE_FLAGS UNIX_COMMAND "${FLAGS}")
+
+  current_time(START)
+  execute_process(
+    COMMAND "${COMPILER}" ${COMPILE_FLAGS} "-I${INCLUDE_DIR}" "-I${SOURCE_DIR}" "${SOURCE}" -o "${BINARY}"
+    RESULT_VARIABLE RESULT
+    )
+  current_time(END)
+
+  if(NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "Failed to build the ${VARIANT} size report program")
+  endif()
+
+  math(EXPR MILLISECONDS "(${END} - ${START}) / 1000")
+  file(SIZE "${BINARY}" FILE_SIZE)
+
+  set(TEXT_SIZE "n/a")
+  if(SIZE_TOOL)
+    execute_process(COMMAND "${SIZE_TOOL}" "${BINARY}" OUTPUT_VARIABLE SIZE_OUTPUT)
+    string(REGEX MATCH "\n[ \t]*([0-9]+)" SIZE_MATCH "${SIZE_OUTPUT}")
+    set(TEXT_SIZE "${CMAKE_MATCH_1}")
+  endif()
+
+  set(${VARIANT}_TEXT ${TEXT_SIZE})
+  set(${VARIANT}_FILE ${FILE_SIZE})
+  set(${VARIANT}_TIME ${MILLISECONDS})
+endforeach()
+
+message("")
+message("sophia::string::format size report (${CALL_SITES} call sites with distinct signatures, flags: ${FLAGS})")
+message("")
+function(print_row)
+  set(LINE "")
+  foreach(CELL ${ARGN})
+    set(PADDED "${CELL}")
+    string(LENGTH "${PADDED}" LENGTH)
+    while(LENGTH LESS 14)
+      set(PADDED " ${PADDED}")
+      string(LENGTH "${PADDED}" LENGTH)
+    endwhile()
+    set(LINE "${LINE}${PADDED}")
+  endforeach()
+  message("${LINE}")
+endfunction()
+
+print_row("variant" "text bytes" "file bytes" "build ms")
+foreach(VARIANT "templated" "erased")
+  print_row(${VARIANT} ${${VARIANT}_TEXT} ${${VARIANT}_FILE} ${${VARIANT}_TIME})
+endforeach()
+
+if(SIZE_TOOL)
+  math(EXPR TEXT_SAVED "${templated_TEXT} - ${erased_TEXT}")
+  message("")
+  message("  text reduction: ${TEXT_SAVED} bytes")
+endif()
+math(EXPR TIME_SAVED "${templated_TIME} - ${erased_TIME}")
+message("  build time reduction: ${TIME_SAVED} ms")